@@ -0,0 +1,148 @@
+#include "AssetArchive.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WINDOWS
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+ImageView const AssetArchive::Texture::get_level(int level) const
+{
+    const unsigned char *pixels = data;
+    int width  = (int) entry->width,
+        height = (int) entry->height;
+
+    for (int i = 0; i < level; i++)
+    {
+        pixels += (std::size_t) width * height * Image::BYTES_PER_PIXEL;
+        width   = std::max(width  / 2, 1);
+        height  = std::max(height / 2, 1);
+    }
+
+    return { width, height, pixels };
+}
+
+int const AssetArchive::Texture::get_level_to_fit(int max_width, int max_height) const
+{
+    return mip_level_to_fit((int) entry->width, (int) entry->height, get_level_count(), max_width, max_height);
+}
+
+// The level chain get_level() walks has to fit inside the entry, and the entry inside the file
+static bool is_entry_valid(const ArchiveEntry &entry, std::size_t archive_size)
+{
+    if (entry.width == 0 || entry.height == 0 || entry.level_count == 0) return false;
+    if (entry.offset > archive_size || entry.byte_size > archive_size - entry.offset) return false;
+
+    uint64_t level_bytes = 0;
+    uint64_t width  = entry.width,
+             height = entry.height;
+
+    for (uint32_t level = 0; level < entry.level_count; level++)
+    {
+        // Compared in texels, which can't overflow, before the byte count is built
+        uint64_t texels = width * height;
+        if (texels > (entry.byte_size - level_bytes) / Image::BYTES_PER_PIXEL) return false;
+        level_bytes += texels * Image::BYTES_PER_PIXEL;
+
+        width  = std::max<uint64_t>(width  / 2, 1);
+        height = std::max<uint64_t>(height / 2, 1);
+    }
+
+    return true;
+}
+
+bool AssetArchive::open(const char *filepath)
+{
+    close();
+
+#ifdef _WINDOWS
+    m_file = CreateFileA(filepath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (m_file == INVALID_HANDLE_VALUE) { m_file = nullptr; return false; }
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(m_file, &file_size))
+    {
+        close();
+        return false;
+    }
+    m_size = (std::size_t) file_size.QuadPart;
+
+    m_mapping = CreateFileMappingA(m_file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (m_mapping != nullptr) m_data = (const unsigned char *) MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+#else
+    m_file = ::open(filepath, O_RDONLY);
+    if (m_file < 0) return false;
+
+    struct stat file_stat;
+    if (fstat(m_file, &file_stat) != 0)
+    {
+        close();
+        return false;
+    }
+    m_size = (std::size_t) file_stat.st_size;
+
+    void *mapped = m_size > 0 ? mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_file, 0) : MAP_FAILED;
+    if (mapped != MAP_FAILED) m_data = (const unsigned char *) mapped;
+#endif
+
+    if (m_data == nullptr || m_size < sizeof(ArchiveHeader))
+    {
+        close();
+        return false;
+    }
+
+    const ArchiveHeader *header = (const ArchiveHeader *) m_data;
+    if (std::memcmp(header->magic, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC)) != 0 || header->version != ARCHIVE_VERSION ||
+        sizeof(ArchiveHeader) + (std::size_t) header->entry_count * sizeof(ArchiveEntry) > m_size)
+    {
+        std::cout << "Asset archive " << filepath << " is not a version " << ARCHIVE_VERSION
+                  << " archive, ignoring it." << std::endl;
+        close();
+        return false;
+    }
+
+    const ArchiveEntry *entries = (const ArchiveEntry *) (m_data + sizeof(ArchiveHeader));
+    for (uint32_t i = 0; i < header->entry_count; i++)
+    {
+        if (!is_entry_valid(entries[i], m_size)) continue;
+        m_entries[std::string(entries[i].name, strnlen(entries[i].name, sizeof(entries[i].name)))] = &entries[i];
+    }
+
+    return true;
+}
+
+void AssetArchive::close()
+{
+    m_entries.clear();
+
+#ifdef _WINDOWS
+    if (m_data != nullptr)    UnmapViewOfFile(m_data);
+    if (m_mapping != nullptr) CloseHandle(m_mapping);
+    if (m_file != nullptr)    CloseHandle(m_file);
+    m_mapping = nullptr;
+    m_file    = nullptr;
+#else
+    if (m_data != nullptr) munmap((void *) m_data, m_size);
+    if (m_file >= 0)       ::close(m_file);
+    m_file = -1;
+#endif
+
+    m_data = nullptr;
+    m_size = 0;
+}
+
+bool AssetArchive::find(const char *filepath, Texture &texture) const
+{
+    auto found = m_entries.find(filepath);
+    if (found == m_entries.end() || found->second->format != ARCHIVE_RGBA8) return false;
+
+    texture.entry = found->second;
+    texture.data  = m_data + found->second->offset;
+    return true;
+}
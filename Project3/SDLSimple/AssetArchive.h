@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include "Image.h"
+
+// ————— ON-DISK LAYOUT ————— //
+// header | entry table | level data. Each entry's levels are stored base first,
+// tightly packed, every level halving both sides down to 1x1
+struct ArchiveHeader
+{
+    char     magic[4];
+    uint32_t version;
+    uint32_t entry_count;
+    uint32_t reserved;
+};
+
+struct ArchiveEntry
+{
+    char     name[112];
+    uint32_t width;
+    uint32_t height;
+    uint32_t level_count;
+    uint32_t format;
+    uint64_t offset;
+    uint64_t byte_size;
+};
+
+enum ArchiveFormat : uint32_t { ARCHIVE_RGBA8 = 0 };
+
+constexpr char     ARCHIVE_MAGIC[4]  = { 'S', 'D', 'L', 'A' };
+constexpr uint32_t ARCHIVE_VERSION   = 1;
+constexpr int      ARCHIVE_ALIGNMENT = 16;
+
+// Read-only view of an archive written by tools/cook_assets.cpp. The file is mapped
+// rather than read, so textures are uploaded straight out of the page cache
+class AssetArchive
+{
+public:
+    // A cooked texture; every pointer stays valid until the archive is closed
+    struct Texture
+    {
+        const ArchiveEntry  *entry = nullptr;
+        const unsigned char *data  = nullptr;
+
+        int const get_level_count() const { return (int) entry->level_count; }
+        ImageView const get_level(int level) const;
+        int const get_level_to_fit(int max_width, int max_height) const;
+    };
+
+private:
+    const unsigned char *m_data = nullptr;
+    std::size_t          m_size = 0;
+
+    std::unordered_map<std::string, const ArchiveEntry*> m_entries;
+
+#ifdef _WINDOWS
+    void *m_file    = nullptr;
+    void *m_mapping = nullptr;
+#else
+    int m_file = -1;
+#endif
+
+public:
+    ~AssetArchive() { close(); }
+
+    // Fails (and leaves the archive closed) if the file is missing or was cooked by another version
+    bool open(const char *filepath);
+    void close();
+
+    bool find(const char *filepath, Texture &texture) const;
+
+    // ————— GETTERS ————— //
+    bool        const is_open()          const { return m_data != nullptr;      }
+    int         const get_entry_count()  const { return (int) m_entries.size(); }
+    std::size_t const get_mapped_bytes() const { return m_size;                 }
+};
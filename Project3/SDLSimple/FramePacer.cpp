@@ -0,0 +1,69 @@
+#include "FramePacer.h"
+
+PacingMode FramePacer::initialise(PacingMode mode, int target_fps)
+{
+    m_frequency = SDL_GetPerformanceFrequency();
+    m_period    = target_fps > 0 ? m_frequency / (Uint64) target_fps : 0;
+    
+    // Negative swap intervals only exist with EXT_swap_control_tear and its relatives
+    if (mode == ADAPTIVE_VSYNC && SDL_GL_SetSwapInterval(-1) != 0) mode = VSYNC;
+    if (mode == VSYNC && SDL_GL_SetSwapInterval(1) != 0)           mode = m_period > 0 ? LIMITED : UNCAPPED;
+    if (mode == LIMITED && m_period == 0)                          mode = UNCAPPED;
+    
+    if (mode == UNCAPPED || mode == LIMITED) SDL_GL_SetSwapInterval(0);
+    
+    m_mode          = mode;
+    m_last_frame    = SDL_GetPerformanceCounter();
+    m_next_deadline = m_last_frame + m_period;
+    m_frame_count   = 0;
+    m_mean          = m_m2 = 0.0;
+    
+    return m_mode;
+}
+
+void FramePacer::wait_until(Uint64 deadline) const
+{
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (now >= deadline) return;
+    
+    double remaining = (double) (deadline - now) / m_frequency;
+    if (remaining > SPIN_MARGIN) SDL_Delay((Uint32) ((remaining - SPIN_MARGIN) * 1000.0));
+    
+    while (SDL_GetPerformanceCounter() < deadline) { }
+}
+
+void FramePacer::end_frame()
+{
+    if (m_mode == LIMITED)
+    {
+        wait_until(m_next_deadline);
+        
+        // Deadlines advance by whole periods so the average rate holds; after a long stall
+        // the schedule restarts from now instead of rushing frames to catch up
+        Uint64 now = SDL_GetPerformanceCounter();
+        m_next_deadline += m_period;
+        if (m_next_deadline < now) m_next_deadline = now + m_period;
+    }
+    
+    Uint64 now = SDL_GetPerformanceCounter();
+    record((double) (now - m_last_frame) / m_frequency);
+    m_last_frame = now;
+}
+
+void FramePacer::restart()
+{
+    m_last_frame    = SDL_GetPerformanceCounter();
+    m_next_deadline = m_last_frame + m_period;
+}
+
+void FramePacer::record(double frame_time)
+{
+    m_frame_count++;
+    if (m_frame_count == 1) m_min = m_max = frame_time;
+    if (frame_time < m_min) m_min = frame_time;
+    if (frame_time > m_max) m_max = frame_time;
+    
+    double delta = frame_time - m_mean;
+    m_mean += delta / m_frame_count;
+    m_m2   += delta * (frame_time - m_mean);
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <SDL.h>
+
+enum PacingMode { VSYNC, ADAPTIVE_VSYNC, UNCAPPED, LIMITED };
+
+// Decides when the next frame may start: the swap interval for the vsync modes, or a
+// sleep-then-spin wait on the performance counter for the limiter. Also keeps running
+// statistics on how long frames actually took
+class FramePacer
+{
+private:
+    PacingMode m_mode = UNCAPPED;
+
+    Uint64 m_frequency     = 1;
+    Uint64 m_period        = 0; // counter ticks per frame in LIMITED mode
+    Uint64 m_next_deadline = 0;
+    Uint64 m_last_frame    = 0;
+
+    // Welford's running mean and variance, in seconds
+    long   m_frame_count = 0;
+    double m_mean        = 0.0,
+           m_m2          = 0.0,
+           m_min         = 0.0,
+           m_max         = 0.0;
+
+    void wait_until(Uint64 deadline) const;
+    void record(double frame_time);
+
+public:
+    // ————— STATIC VARIABLES ————— //
+    // SDL_Delay can overshoot by a scheduler tick, so the last stretch before a deadline is spun
+    static constexpr double SPIN_MARGIN = 0.002;
+
+    // ————— METHODS ————— //
+    // Needs a current context. Returns the mode actually in effect: adaptive falls back to plain
+    // vsync, and vsync to the limiter, when the driver refuses the swap interval
+    PacingMode initialise(PacingMode mode, int target_fps);
+
+    // Call right after SDL_GL_SwapWindow
+    void end_frame();
+    
+    // Starts the next frame's clock from now, so time spent blocked outside the loop
+    // neither counts as a frame nor leaves the limiter chasing missed deadlines
+    void restart();
+
+    // ————— GETTERS ————— //
+    PacingMode const get_mode()        const { return m_mode;        }
+    long       const get_frame_count() const { return m_frame_count; }
+    double     const get_mean_frame_time() const { return m_mean; }
+    double     const get_frame_time_variance() const { return m_frame_count > 1 ? m_m2 / (m_frame_count - 1) : 0.0; }
+    double     const get_min_frame_time() const { return m_min; }
+    double     const get_max_frame_time() const { return m_max; }
+};
@@ -0,0 +1,128 @@
+#define GL_SILENCE_DEPRECATION
+
+#include <SDL.h>
+#include "GLExtensions.h"
+#include <cstdio>
+
+GLExtensions g_gl_extensions;
+
+// 2.1 -> 21, 3.3 -> 33
+static int gl_version()
+{
+    const char *version = (const char *) glGetString(GL_VERSION);
+    int major = 0, minor = 0;
+    
+    if (version == nullptr || sscanf(version, "%d.%d", &major, &minor) < 1) return 0;
+    return major * 10 + minor;
+}
+
+template <typename Function>
+static bool load_function(Function &function, const char *name)
+{
+    function = (Function) SDL_GL_GetProcAddress(name);
+    return function != nullptr;
+}
+
+void load_gl_extensions()
+{
+    int version = gl_version();
+    
+    // ————— VERTEX ARRAY OBJECTS ————— //
+    if (version >= 30 || SDL_GL_ExtensionSupported("GL_ARB_vertex_array_object"))
+    {
+        g_gl_extensions.vertex_array_object =
+            load_function(g_gl_extensions.gen_vertex_arrays,    "glGenVertexArrays") &&
+            load_function(g_gl_extensions.bind_vertex_array,    "glBindVertexArray") &&
+            load_function(g_gl_extensions.delete_vertex_arrays, "glDeleteVertexArrays");
+    }
+    if (!g_gl_extensions.vertex_array_object && SDL_GL_ExtensionSupported("GL_APPLE_vertex_array_object"))
+    {
+        g_gl_extensions.vertex_array_object =
+            load_function(g_gl_extensions.gen_vertex_arrays,    "glGenVertexArraysAPPLE") &&
+            load_function(g_gl_extensions.bind_vertex_array,    "glBindVertexArrayAPPLE") &&
+            load_function(g_gl_extensions.delete_vertex_arrays, "glDeleteVertexArraysAPPLE");
+    }
+    
+    // ————— INSTANCING ————— //
+    bool has_divisor = false, has_draw_instanced = false;
+    
+    if (version >= 33) has_divisor = load_function(g_gl_extensions.vertex_attrib_divisor, "glVertexAttribDivisor");
+    if (!has_divisor && SDL_GL_ExtensionSupported("GL_ARB_instanced_arrays"))
+        has_divisor = load_function(g_gl_extensions.vertex_attrib_divisor, "glVertexAttribDivisorARB");
+    
+    if (version >= 31) has_draw_instanced = load_function(g_gl_extensions.draw_elements_instanced, "glDrawElementsInstanced");
+    if (!has_draw_instanced && SDL_GL_ExtensionSupported("GL_ARB_draw_instanced"))
+        has_draw_instanced = load_function(g_gl_extensions.draw_elements_instanced, "glDrawElementsInstancedARB");
+    if (!has_draw_instanced && SDL_GL_ExtensionSupported("GL_EXT_draw_instanced"))
+        has_draw_instanced = load_function(g_gl_extensions.draw_elements_instanced, "glDrawElementsInstancedEXT");
+    
+    g_gl_extensions.instancing = has_divisor && has_draw_instanced;
+    
+    // ————— IMMUTABLE TEXTURE STORAGE ————— //
+    if (version >= 42 || SDL_GL_ExtensionSupported("GL_ARB_texture_storage"))
+        g_gl_extensions.texture_storage = load_function(g_gl_extensions.tex_storage_2d, "glTexStorage2D");
+    if (!g_gl_extensions.texture_storage && SDL_GL_ExtensionSupported("GL_EXT_texture_storage"))
+        g_gl_extensions.texture_storage = load_function(g_gl_extensions.tex_storage_2d, "glTexStorage2DEXT");
+    
+    // ————— UNIFORM BUFFER OBJECTS ————— //
+    // The shaders opt in through #extension, so the extension string is required even on 3.1+
+    if (SDL_GL_ExtensionSupported("GL_ARB_uniform_buffer_object"))
+    {
+        g_gl_extensions.uniform_buffer_object =
+            load_function(g_gl_extensions.get_uniform_block_index, "glGetUniformBlockIndex") &&
+            load_function(g_gl_extensions.uniform_block_binding,   "glUniformBlockBinding")  &&
+            load_function(g_gl_extensions.bind_buffer_base,        "glBindBufferBase");
+    }
+    
+    // ————— PROGRAM BINARIES ————— //
+    if (version >= 41 || SDL_GL_ExtensionSupported("GL_ARB_get_program_binary"))
+    {
+        g_gl_extensions.program_binary =
+            load_function(g_gl_extensions.get_program_binary,  "glGetProgramBinary") &&
+            load_function(g_gl_extensions.program_binary_load, "glProgramBinary")    &&
+            load_function(g_gl_extensions.program_parameteri,  "glProgramParameteri");
+    }
+    
+    // A driver may expose the entry points yet accept no binary formats at all
+    if (g_gl_extensions.program_binary)
+    {
+        GLint format_count = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &format_count);
+        g_gl_extensions.program_binary = format_count > 0;
+    }
+    
+    // ————— PARALLEL SHADER COMPILATION ————— //
+    if (SDL_GL_ExtensionSupported("GL_KHR_parallel_shader_compile"))
+        g_gl_extensions.parallel_shader_compile =
+            load_function(g_gl_extensions.max_shader_compiler_threads, "glMaxShaderCompilerThreadsKHR");
+    if (!g_gl_extensions.parallel_shader_compile && SDL_GL_ExtensionSupported("GL_ARB_parallel_shader_compile"))
+        g_gl_extensions.parallel_shader_compile =
+            load_function(g_gl_extensions.max_shader_compiler_threads, "glMaxShaderCompilerThreadsARB");
+    
+    // 0xFFFFFFFF lets the driver pick how many compiler threads to use
+    if (g_gl_extensions.parallel_shader_compile) g_gl_extensions.max_shader_compiler_threads(0xFFFFFFFF);
+    
+    // ————— FRAMEBUFFER OBJECTS ————— //
+    // The EXT entry points take the same enum values, so either set serves the same callers
+    if (version >= 30 || SDL_GL_ExtensionSupported("GL_ARB_framebuffer_object"))
+    {
+        g_gl_extensions.framebuffer_object =
+            load_function(g_gl_extensions.gen_framebuffers,         "glGenFramebuffers")        &&
+            load_function(g_gl_extensions.bind_framebuffer,         "glBindFramebuffer")        &&
+            load_function(g_gl_extensions.delete_framebuffers,      "glDeleteFramebuffers")     &&
+            load_function(g_gl_extensions.framebuffer_texture_2d,   "glFramebufferTexture2D")   &&
+            load_function(g_gl_extensions.check_framebuffer_status, "glCheckFramebufferStatus");
+    }
+    if (!g_gl_extensions.framebuffer_object && SDL_GL_ExtensionSupported("GL_EXT_framebuffer_object"))
+    {
+        g_gl_extensions.framebuffer_object =
+            load_function(g_gl_extensions.gen_framebuffers,         "glGenFramebuffersEXT")        &&
+            load_function(g_gl_extensions.bind_framebuffer,         "glBindFramebufferEXT")        &&
+            load_function(g_gl_extensions.delete_framebuffers,      "glDeleteFramebuffersEXT")     &&
+            load_function(g_gl_extensions.framebuffer_texture_2d,   "glFramebufferTexture2DEXT")   &&
+            load_function(g_gl_extensions.check_framebuffer_status, "glCheckFramebufferStatusEXT");
+    }
+    
+    // ————— S3TC TEXTURE COMPRESSION ————— //
+    g_gl_extensions.texture_compression_s3tc = SDL_GL_ExtensionSupported("GL_EXT_texture_compression_s3tc");
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#ifdef _WINDOWS
+    #include <GL/glew.h>
+#endif
+#define GL_GLEXT_PROTOTYPES 1
+#include <SDL_opengl.h>
+
+#ifndef APIENTRY
+    #define APIENTRY
+#endif
+
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+    #define GL_COMPRESSED_RGB_S3TC_DXT1_EXT  0x83F0
+    #define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+    #define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+#ifndef GL_UNIFORM_BUFFER
+    #define GL_UNIFORM_BUFFER 0x8A11
+    #define GL_INVALID_INDEX  0xFFFFFFFFu
+#endif
+
+#ifndef GL_COMPLETION_STATUS_KHR
+    #define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
+#ifndef GL_PROGRAM_BINARY_LENGTH
+    #define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+    #define GL_PROGRAM_BINARY_LENGTH           0x8741
+    #define GL_NUM_PROGRAM_BINARY_FORMATS      0x87FE
+#endif
+
+#ifndef GL_FRAMEBUFFER
+    #define GL_FRAMEBUFFER          0x8D40
+    #define GL_FRAMEBUFFER_COMPLETE 0x8CD5
+    #define GL_FRAMEBUFFER_BINDING  0x8CA6
+    #define GL_COLOR_ATTACHMENT0    0x8CE0
+#endif
+
+// Entry points beyond the GL 2.1 legacy context we create on macOS are looked
+// up at runtime, so every feature here has a flag and a fallback path
+struct GLExtensions
+{
+    // ————— VERTEX ARRAY OBJECTS ————— //
+    bool vertex_array_object = false;
+    void (APIENTRY *gen_vertex_arrays)(GLsizei count, GLuint *arrays)          = nullptr;
+    void (APIENTRY *bind_vertex_array)(GLuint array)                           = nullptr;
+    void (APIENTRY *delete_vertex_arrays)(GLsizei count, const GLuint *arrays) = nullptr;
+
+    // ————— INSTANCING ————— //
+    bool instancing = false;
+    void (APIENTRY *vertex_attrib_divisor)(GLuint index, GLuint divisor) = nullptr;
+    void (APIENTRY *draw_elements_instanced)(GLenum mode, GLsizei count, GLenum type,
+                                             const void *indices, GLsizei instance_count) = nullptr;
+
+    // ————— IMMUTABLE TEXTURE STORAGE ————— //
+    bool texture_storage = false;
+    void (APIENTRY *tex_storage_2d)(GLenum target, GLsizei levels, GLenum internal_format,
+                                    GLsizei width, GLsizei height) = nullptr;
+
+    // ————— UNIFORM BUFFER OBJECTS ————— //
+    bool uniform_buffer_object = false;
+    GLuint (APIENTRY *get_uniform_block_index)(GLuint program, const GLchar *name)               = nullptr;
+    void   (APIENTRY *uniform_block_binding)(GLuint program, GLuint block_index, GLuint binding) = nullptr;
+    void   (APIENTRY *bind_buffer_base)(GLenum target, GLuint index, GLuint buffer)              = nullptr;
+
+    // ————— PROGRAM BINARIES ————— //
+    bool program_binary = false;
+    void (APIENTRY *get_program_binary)(GLuint program, GLsizei buffer_size, GLsizei *length,
+                                        GLenum *binary_format, void *binary)                            = nullptr;
+    void (APIENTRY *program_binary_load)(GLuint program, GLenum binary_format, const void *binary,
+                                         GLsizei length)                                                = nullptr;
+    void (APIENTRY *program_parameteri)(GLuint program, GLenum name, GLint value)                      = nullptr;
+
+    // ————— PARALLEL SHADER COMPILATION ————— //
+    bool parallel_shader_compile = false;
+    void (APIENTRY *max_shader_compiler_threads)(GLuint count) = nullptr;
+
+    // ————— FRAMEBUFFER OBJECTS ————— //
+    bool framebuffer_object = false;
+    void   (APIENTRY *gen_framebuffers)(GLsizei count, GLuint *framebuffers)          = nullptr;
+    void   (APIENTRY *bind_framebuffer)(GLenum target, GLuint framebuffer)            = nullptr;
+    void   (APIENTRY *delete_framebuffers)(GLsizei count, const GLuint *framebuffers) = nullptr;
+    void   (APIENTRY *framebuffer_texture_2d)(GLenum target, GLenum attachment, GLenum texture_target,
+                                              GLuint texture, GLint level)            = nullptr;
+    GLenum (APIENTRY *check_framebuffer_status)(GLenum target)                        = nullptr;
+
+    // ————— S3TC TEXTURE COMPRESSION ————— //
+    // glCompressedTexImage2D itself is core since 1.3; only the BC1/BC3 formats need the extension
+    bool texture_compression_s3tc = false;
+};
+
+extern GLExtensions g_gl_extensions;
+
+// Must be called once a context is current
+void load_gl_extensions();
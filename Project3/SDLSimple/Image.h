@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Non-owning RGBA8 pixels, e.g. a level that lives inside a mapped asset archive
+struct ImageView
+{
+    int width  = 0;
+    int height = 0;
+    const unsigned char *pixels = nullptr;
+};
+
+// Decoded RGBA8 pixels, rows top to bottom as stb_image returns them
+struct Image
+{
+    int width  = 0;
+    int height = 0;
+    std::vector<unsigned char> pixels;
+
+    static constexpr int BYTES_PER_PIXEL = 4;
+
+    unsigned char* const pixel(int x, int y) { return &pixels[((std::size_t) y * width + x) * BYTES_PER_PIXEL]; }
+    const unsigned char* const pixel(int x, int y) const { return &pixels[((std::size_t) y * width + x) * BYTES_PER_PIXEL]; }
+
+    ImageView const view() const { return { width, height, pixels.data() }; }
+};
+
+bool load_image(const char *filepath, Image &image);
+
+// Area-averaging resample; colour is weighted by alpha so transparent texels don't darken edges
+Image resize_image(const Image &source, int width, int height);
+
+// True when every texel has full alpha, so the image can be drawn without blending
+bool is_opaque(const ImageView &image);
+
+// Shrinks the image so neither side exceeds the limit, keeping it untouched if it already fits.
+// A limit of 0 leaves that axis alone
+void downscale_to_fit(Image &image, int max_width, int max_height);
+
+// Fills levels 1 and up (the base is level 0 and is not copied); each level halves both
+// sides until 1x1 or until max_levels including the base is reached
+void build_mip_chain(const Image &base, std::vector<Image> &levels, int max_levels);
+
+// For a chain whose levels halve from width x height: the smallest level that still covers
+// the size downscale_to_fit() would produce, so nothing larger than needed is uploaded
+int mip_level_to_fit(int width, int height, int level_count, int max_width, int max_height);
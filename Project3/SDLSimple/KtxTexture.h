@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ————— ON-DISK LAYOUT ————— //
+// The subset of KTX2 written by tools/cook_ktx2.cpp: one 2D image, no supercompression,
+// level index ordered base first (the level data itself is stored smallest first)
+struct Ktx2Header
+{
+    uint8_t  identifier[12];
+    uint32_t vk_format;
+    uint32_t type_size;
+    uint32_t pixel_width;
+    uint32_t pixel_height;
+    uint32_t pixel_depth;
+    uint32_t layer_count;
+    uint32_t face_count;
+    uint32_t level_count;
+    uint32_t supercompression_scheme;
+    uint32_t dfd_byte_offset;
+    uint32_t dfd_byte_length;
+    uint32_t kvd_byte_offset;
+    uint32_t kvd_byte_length;
+    uint64_t sgd_byte_offset;
+    uint64_t sgd_byte_length;
+};
+
+struct Ktx2LevelIndex
+{
+    uint64_t byte_offset;
+    uint64_t byte_length;
+    uint64_t uncompressed_byte_length;
+};
+
+constexpr uint8_t KTX2_IDENTIFIER[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+// Vulkan format numbers, which is how KTX2 names its formats
+enum KtxFormat : uint32_t
+{
+    KTX_BC1_RGB_UNORM  = 131,
+    KTX_BC1_RGBA_UNORM = 133,
+    KTX_BC3_UNORM      = 137
+};
+
+// A block-compressed texture read from a .ktx2 file, kept in memory only until it is uploaded
+class KtxTexture
+{
+public:
+    struct Level
+    {
+        int width  = 0;
+        int height = 0;
+        const unsigned char *data = nullptr;
+        std::size_t byte_size     = 0;
+    };
+
+private:
+    std::vector<unsigned char> m_file;
+
+    const Ktx2Header*     const get_header() const { return (const Ktx2Header *) m_file.data(); }
+    const Ktx2LevelIndex* const get_index()  const { return (const Ktx2LevelIndex *) (m_file.data() + sizeof(Ktx2Header)); }
+
+public:
+    // Fails for anything other than an uncompressed-container BC1/BC3 2D texture
+    bool load(const char *filepath);
+
+    // "assets/submarine.png" -> "assets/submarine.ktx2"
+    static std::string path_for(const char *source_path);
+
+    // Bytes per 4x4 block
+    static int block_size(uint32_t vk_format) { return vk_format == KTX_BC3_UNORM ? 16 : 8; }
+
+    // ————— GETTERS ————— //
+    uint32_t const get_vk_format()   const { return get_header()->vk_format;              }
+    int      const get_width()       const { return (int) get_header()->pixel_width;      }
+    int      const get_height()      const { return (int) get_header()->pixel_height;     }
+    int      const get_level_count() const { return (int) get_header()->level_count;      }
+    Level    const get_level(int level) const;
+    int      const get_level_to_fit(int max_width, int max_height) const;
+};
@@ -0,0 +1,77 @@
+#define GL_SILENCE_DEPRECATION
+
+#include "RenderQueue.h"
+#include "SpriteRenderer.h"
+#include <cstring>
+
+// Maps a float onto an unsigned integer that sorts in the same order
+static uint32_t sortable_bits(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x80000000u) != 0 ? ~bits : bits | 0x80000000u;
+}
+
+void RenderQueue::begin(bool depth_tested)
+{
+    m_commands.clear();
+    m_depth_tested = depth_tested;
+}
+
+uint64_t RenderQueue::make_key(bool opaque, int layer, GLuint program, GLuint texture, float depth) const
+{
+    uint64_t depth_bits = sortable_bits(depth),
+             // Names only need to group equal state, so wrapping into the field is harmless
+             state_bits = ((uint64_t) (program & 0xFF) << 16) | (uint64_t) (texture & 0xFFFF),
+             layer_bits = (uint64_t) (layer & (MAX_LAYERS - 1));
+    
+    if (opaque && m_depth_tested)
+    {
+        layer_bits = (MAX_LAYERS - 1) - layer_bits;
+        depth_bits = ~depth_bits & 0xFFFFFFFFull;
+        return (layer_bits << 56) | (state_bits << 32) | depth_bits;
+    }
+    
+    uint64_t pass_bits = m_depth_tested && !opaque ? TRANSLUCENT_BIT : 0;
+    return pass_bits | (layer_bits << 56) | (depth_bits << 24) | state_bits;
+}
+
+void RenderQueue::submit(const SpriteSnapshot &sprite, int layer, GLuint program)
+{
+    m_commands.push_back({ make_key(sprite.opaque, layer, program, sprite.texture_id, sprite.depth), sprite, nullptr });
+}
+
+void RenderQueue::submit(const SpriteInstanceGroup *instances, const SpriteSnapshot &sample, int layer, GLuint program)
+{
+    m_commands.push_back({ make_key(sample.opaque, layer, program, instances->get_texture_id(), sample.depth),
+                           sample, instances });
+}
+
+void RenderQueue::sort()
+{
+    std::size_t count = m_commands.size();
+    if (count < 2) return;
+    
+    m_scratch.resize(count);
+    
+    for (int shift = 0; shift < 64; shift += RADIX_BITS)
+    {
+        std::size_t offsets[RADIX_SIZE] = {};
+        for (const RenderCommand &command : m_commands) offsets[(command.key >> shift) & (RADIX_SIZE - 1)]++;
+        
+        if (offsets[(m_commands[0].key >> shift) & (RADIX_SIZE - 1)] == count) continue;
+        
+        std::size_t total = 0;
+        for (std::size_t &offset : offsets)
+        {
+            std::size_t digit_count = offset;
+            offset = total;
+            total += digit_count;
+        }
+        
+        for (const RenderCommand &command : m_commands)
+            m_scratch[offsets[(command.key >> shift) & (RADIX_SIZE - 1)]++] = command;
+        
+        m_commands.swap(m_scratch);
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#ifdef _WINDOWS
+    #include <GL/glew.h>
+#endif
+#define GL_GLEXT_PROTOTYPES 1
+#include <SDL_opengl.h>
+#include <cstdint>
+#include <vector>
+#include "SpriteSnapshot.h"
+
+class SpriteInstanceGroup;
+
+// One sprite, or one instanced group, waiting to be drawn. The sprite is copied in, so a
+// command stays valid however the entity it came from changes before the queue is drawn
+struct RenderCommand
+{
+    uint64_t                   key;
+    SpriteSnapshot             sprite;
+    const SpriteInstanceGroup *instances;
+};
+
+// Draw packets are submitted in any order and come back sorted by a 64-bit key, so layering is
+// spelled out per packet and program/texture switches are grouped wherever ordering allows.
+// From the top bit down:
+//     depth-tested, opaque:      pass | layer (nearest first) | program | texture | depth (nearest first)
+//     depth-tested, translucent: pass | layer                 | depth   | program | texture
+//     no depth buffer:                  layer                 | depth   | program | texture
+// Opaque sprites behind a depth buffer can be drawn in any order, so state comes before depth;
+// blended sprites must stay back to front, so depth comes first. Without a depth buffer nothing
+// can be drawn out of order, so there is no pass split and opaque and translucent sprites interleave
+class RenderQueue
+{
+private:
+    static constexpr int RADIX_BITS = 8;
+    static constexpr int RADIX_SIZE = 1 << RADIX_BITS;
+
+    std::vector<RenderCommand> m_commands;
+    std::vector<RenderCommand> m_scratch;
+
+    bool m_depth_tested = false;
+
+    uint64_t make_key(bool opaque, int layer, GLuint program, GLuint texture, float depth) const;
+
+public:
+    // ————— STATIC VARIABLES ————— //
+    static constexpr int      MAX_LAYERS      = 128;
+    static constexpr uint64_t TRANSLUCENT_BIT = 1ull << 63;
+
+    // ————— METHODS ————— //
+    // Empties the queue; depth_tested says whether the target being drawn to has a depth buffer
+    void begin(bool depth_tested);
+
+    // Lower layers are drawn behind higher ones; within a layer, larger depth is nearer
+    void submit(const SpriteSnapshot &sprite, int layer, GLuint program);
+    // All members of the group share its texture, and the sample stands in for their opacity and depth
+    void submit(const SpriteInstanceGroup *instances, const SpriteSnapshot &sample, int layer, GLuint program);
+
+    // Stable LSD radix sort, one byte per pass, skipping bytes every key shares
+    void sort();
+
+    // ————— GETTERS ————— //
+    const std::vector<RenderCommand> &get_commands() const { return m_commands; }
+    bool const is_depth_tested() const { return m_depth_tested; }
+
+    static bool const is_translucent(const RenderCommand &command) { return !command.sprite.opaque; }
+};
@@ -0,0 +1,126 @@
+#define GL_SILENCE_DEPRECATION
+
+#include "ShaderCache.h"
+#include "GLExtensions.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+constexpr char CACHE_MAGIC[4] = { 'S', 'P', 'B', '1' };
+
+ShaderCache g_shader_cache;
+
+uint64_t ShaderCache::hash(std::string_view text, uint64_t seed)
+{
+    uint64_t result = seed;
+    for (unsigned char character : text)
+    {
+        result ^= character;
+        result *= 1099511628211ull;
+    }
+    return result;
+}
+
+uint64_t ShaderCache::source_hash(std::string_view vertex_source, std::string_view fragment_source)
+{
+    // Chained, so swapping text between the two stages still changes the key
+    return hash(fragment_source, hash(vertex_source) ^ 0x9E3779B97F4A7C15ull);
+}
+
+void ShaderCache::initialise(const char *directory)
+{
+    m_directory.clear();
+    if (!g_gl_extensions.program_binary || directory == nullptr) return;
+
+    std::string driver;
+    for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION })
+    {
+        const char *value = (const char *) glGetString(name);
+        driver += value != nullptr ? value : "";
+        driver += '\n';
+    }
+
+    m_driver_hash = hash(driver);
+    m_directory   = directory;
+}
+
+std::string ShaderCache::entry_path(uint64_t source_hash) const
+{
+    char name[64];
+    snprintf(name, sizeof(name), "shader-%016llx-%016llx.bin",
+             (unsigned long long) m_driver_hash, (unsigned long long) source_hash);
+    return m_directory + name;
+}
+
+void ShaderCache::prepare(GLuint program) const
+{
+    if (is_initialised()) g_gl_extensions.program_parameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+}
+
+bool ShaderCache::load(GLuint program, uint64_t source_hash)
+{
+    if (!is_initialised()) return false;
+
+    std::ifstream file(entry_path(source_hash), std::ios::binary);
+    EntryHeader header;
+
+    if (!file.read((char *) &header, sizeof(header)) ||
+        std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 ||
+        header.driver_hash != m_driver_hash || header.source_hash != source_hash)
+    {
+        m_misses++;
+        return false;
+    }
+
+    std::vector<char> binary(header.binary_length);
+    if (!file.read(binary.data(), binary.size()))
+    {
+        m_misses++;
+        return false;
+    }
+
+    g_gl_extensions.program_binary_load(program, header.binary_format, binary.data(), (GLsizei) binary.size());
+
+    // Drivers are free to reject a binary they produced themselves, so the link status has the last word
+    GLint link_success = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &link_success);
+
+    if (link_success == GL_TRUE) m_hits++;
+    else                         m_misses++;
+
+    return link_success == GL_TRUE;
+}
+
+void ShaderCache::store(GLuint program, uint64_t source_hash) const
+{
+    if (!is_initialised()) return;
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+
+    std::vector<char> binary(length);
+    EntryHeader header;
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    GLenum binary_format = 0;
+    g_gl_extensions.get_program_binary(program, length, &length, &binary_format, binary.data());
+
+    header.binary_format = binary_format;
+    header.driver_hash   = m_driver_hash;
+    header.source_hash   = source_hash;
+    header.binary_length = (uint64_t) length;
+
+    // Written under a temporary name, so a crash mid-write never leaves a truncated entry behind
+    std::string path = entry_path(source_hash), temporary_path = path + ".tmp";
+    {
+        std::ofstream file(temporary_path, std::ios::binary);
+        if (!file) return;
+
+        file.write((const char *) &header, sizeof(header));
+        file.write(binary.data(), length);
+        if (!file) return;
+    }
+    std::remove(path.c_str());
+    std::rename(temporary_path.c_str(), path.c_str());
+}
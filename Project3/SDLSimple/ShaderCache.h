@@ -0,0 +1,56 @@
+#pragma once
+
+#ifdef _WINDOWS
+    #include <GL/glew.h>
+#endif
+#define GL_GLEXT_PROTOTYPES 1
+#include <SDL_opengl.h>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Keeps linked program binaries on disk so later launches skip the driver's compiler.
+// Entries are keyed by the driver (vendor, renderer, version) and the shader sources,
+// so a driver update or an edited shader simply misses and recompiles
+class ShaderCache
+{
+private:
+    struct EntryHeader
+    {
+        char     magic[4];
+        uint32_t binary_format;
+        uint64_t driver_hash;
+        uint64_t source_hash;
+        uint64_t binary_length;
+    };
+
+    std::string entry_path(uint64_t source_hash) const;
+
+    std::string m_directory;
+    uint64_t    m_driver_hash = 0;
+
+    int m_hits   = 0;
+    int m_misses = 0;
+
+public:
+    // FNV-1a; stable across runs and platforms, unlike std::hash
+    static uint64_t hash(std::string_view text, uint64_t seed = 14695981039346656037ull);
+    static uint64_t source_hash(std::string_view vertex_source, std::string_view fragment_source);
+
+    // Needs a current context. Leaves the cache disabled when the driver cannot hand out binaries
+    void initialise(const char *directory);
+
+    // Must be called before glLinkProgram for store() to be able to read the binary back
+    void prepare(GLuint program) const;
+
+    // True if the program was restored and linked from a cached binary
+    bool load(GLuint program, uint64_t source_hash);
+    void store(GLuint program, uint64_t source_hash) const;
+
+    // ————— GETTERS ————— //
+    bool const is_initialised() const { return !m_directory.empty(); }
+    int  const get_hits()       const { return m_hits;   }
+    int  const get_misses()     const { return m_misses; }
+};
+
+extern ShaderCache g_shader_cache;
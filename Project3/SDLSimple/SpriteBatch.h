@@ -0,0 +1,53 @@
+#pragma once
+
+#ifdef _WINDOWS
+    #include <GL/glew.h>
+#endif
+#define GL_GLEXT_PROTOTYPES 1
+#include <SDL_opengl.h>
+#include <vector>
+#include "glm/mat4x4.hpp"
+#include "glm/vec4.hpp"
+#include "ShaderProgram.h"
+#include "Transform2D.h"
+
+class SpriteBatch
+{
+private:
+    struct SpriteVertex
+    {
+        float x, y, z;
+        float u, v;
+    };
+
+    void flush();
+
+    std::vector<SpriteVertex> m_vertices;
+
+    GLuint m_vertex_buffer   = 0;
+    GLuint m_current_texture = 0;
+
+    ShaderProgram *m_program = nullptr;
+
+    int m_draw_calls    = 0;
+    int m_sprite_count  = 0;
+
+public:
+    // ————— STATIC VARIABLES ————— //
+    static constexpr int MAX_SPRITES       = 4096;
+    static constexpr int VERTICES_PER_QUAD = 6;
+
+    // ————— METHODS ————— //
+    void initialise();
+    void cleanup();
+
+    // Every quad between begin() and end() is drawn with the given program; a
+    // new draw call is only issued when the texture changes or the buffer fills
+    void begin(ShaderProgram *program);
+    void draw(GLuint texture_id, const Transform2D &transform, const glm::vec4 &uv_rect);
+    void end();
+
+    // ————— GETTERS ————— //
+    int const get_draw_calls()   const { return m_draw_calls;   }
+    int const get_sprite_count() const { return m_sprite_count; }
+};
@@ -0,0 +1,226 @@
+#define GL_SILENCE_DEPRECATION
+
+#include "SpriteRenderer.h"
+#include "GLExtensions.h"
+#include <cstddef>
+
+void SpriteRenderer::initialise(ShaderProgram *program)
+{
+    m_program = program;
+    
+    // Texture coordinates follow the orientation Entity has always used: v = 1 at the bottom edge
+    QuadVertex vertices[] =
+    {
+        { -0.5f, -0.5f, 0.0f, 1.0f },
+        {  0.5f, -0.5f, 1.0f, 1.0f },
+        {  0.5f,  0.5f, 1.0f, 0.0f },
+        { -0.5f,  0.5f, 0.0f, 0.0f }
+    };
+    GLushort indices[] = { 0, 1, 2, 0, 2, 3 };
+    
+    glGenBuffers(1, &m_vertex_buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, m_vertex_buffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+    
+    glGenBuffers(1, &m_index_buffer);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_index_buffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+    
+    if (g_gl_extensions.vertex_array_object)
+    {
+        g_gl_extensions.gen_vertex_arrays(1, &m_vertex_array);
+        g_gl_extensions.bind_vertex_array(m_vertex_array);
+        
+        // The VAO captures the attribute pointers and the element buffer binding
+        glBindBuffer(GL_ARRAY_BUFFER, m_vertex_buffer);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_index_buffer);
+        bind_attributes();
+        
+        g_gl_extensions.bind_vertex_array(0);
+    }
+    
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+void SpriteRenderer::cleanup()
+{
+    if (m_vertex_array != 0) g_gl_extensions.delete_vertex_arrays(1, &m_vertex_array);
+    glDeleteBuffers(1, &m_vertex_buffer);
+    glDeleteBuffers(1, &m_index_buffer);
+    
+    m_vertex_array  = 0;
+    m_vertex_buffer = 0;
+    m_index_buffer  = 0;
+}
+
+void SpriteRenderer::bind_attributes()
+{
+    glVertexAttribPointer(m_program->get_position_attribute(), 2, GL_FLOAT, false,
+                          sizeof(QuadVertex), (const void *) offsetof(QuadVertex, x));
+    glEnableVertexAttribArray(m_program->get_position_attribute());
+    glVertexAttribPointer(m_program->get_tex_coordinate_attribute(), 2, GL_FLOAT, false,
+                          sizeof(QuadVertex), (const void *) offsetof(QuadVertex, u));
+    glEnableVertexAttribArray(m_program->get_tex_coordinate_attribute());
+}
+
+void SpriteRenderer::unbind_attributes()
+{
+    glDisableVertexAttribArray(m_program->get_position_attribute());
+    glDisableVertexAttribArray(m_program->get_tex_coordinate_attribute());
+}
+
+void SpriteRenderer::begin()
+{
+    m_program->use();
+    if (m_bound) return;
+    
+    if (m_vertex_array != 0)
+    {
+        g_gl_extensions.bind_vertex_array(m_vertex_array);
+    }
+    else
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, m_vertex_buffer);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_index_buffer);
+        bind_attributes();
+    }
+    
+    m_bound = true;
+}
+
+void SpriteRenderer::draw(GLuint texture_id, const Transform2D &transform, const glm::vec4 &uv_rect)
+{
+    bool was_bound = m_bound;
+    begin();
+    
+    m_program->set_model_transform(transform);
+    m_program->set_uv_rect(uv_rect);
+    
+    glBindTexture(GL_TEXTURE_2D, texture_id);
+    glDrawElements(GL_TRIANGLES, INDICES_PER_QUAD, GL_UNSIGNED_SHORT, nullptr);
+    
+    // A lone draw outside begin()/end() leaves no state behind
+    if (!was_bound) end();
+}
+
+void SpriteRenderer::end()
+{
+    if (!m_bound) return;
+    
+    if (m_vertex_array != 0)
+    {
+        g_gl_extensions.bind_vertex_array(0);
+    }
+    else
+    {
+        unbind_attributes();
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    }
+    
+    // Other paths assume the default UV rectangle
+    m_program->set_uv_rect(glm::vec4(0.0f, 0.0f, 1.0f, 1.0f));
+    m_bound = false;
+}
+
+void SpriteRenderer::draw_instanced(ShaderProgram *instanced_program, const SpriteInstanceGroup &group)
+{
+    if (group.get_instance_count() == 0) return;
+    
+    bool was_bound = m_bound;
+    
+    if (!g_gl_extensions.instancing || instanced_program->get_instance_linear_attribute() < 0)
+    {
+        begin();
+        for (const SpriteInstance &instance : group.get_instances())
+            draw(group.get_texture_id(), instance.transform, instance.uv_rect);
+        if (!was_bound) end();
+        return;
+    }
+    
+    // The VAO records the sprite program's layout, so the instanced layout is bound by hand
+    end();
+    instanced_program->use();
+    
+    glBindTexture(GL_TEXTURE_2D, group.get_texture_id());
+    
+    glBindBuffer(GL_ARRAY_BUFFER, m_vertex_buffer);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_index_buffer);
+    glVertexAttribPointer(instanced_program->get_position_attribute(), 2, GL_FLOAT, false,
+                          sizeof(QuadVertex), (const void *) offsetof(QuadVertex, x));
+    glEnableVertexAttribArray(instanced_program->get_position_attribute());
+    glVertexAttribPointer(instanced_program->get_tex_coordinate_attribute(), 2, GL_FLOAT, false,
+                          sizeof(QuadVertex), (const void *) offsetof(QuadVertex, u));
+    glEnableVertexAttribArray(instanced_program->get_tex_coordinate_attribute());
+    
+    struct InstanceAttribute
+    {
+        GLint       location;
+        GLint       components;
+        std::size_t offset;
+    };
+    
+    InstanceAttribute candidates[INSTANCE_ATTRIBUTE_COUNT] =
+    {
+        { instanced_program->get_instance_linear_attribute(),      4, offsetof(SpriteInstance, transform) + offsetof(Transform2D, linear)      },
+        { instanced_program->get_instance_translation_attribute(), 3, offsetof(SpriteInstance, transform) + offsetof(Transform2D, translation) },
+        { instanced_program->get_instance_uv_rect_attribute(),     4, offsetof(SpriteInstance, uv_rect) },
+        { instanced_program->get_instance_tint_attribute(),        4, offsetof(SpriteInstance, tint)    }
+    };
+    
+    GLint instance_attributes[INSTANCE_ATTRIBUTE_COUNT];
+    int attribute_count = 0;
+    
+    glBindBuffer(GL_ARRAY_BUFFER, group.get_instance_buffer());
+    for (const InstanceAttribute &attribute : candidates)
+    {
+        if (attribute.location < 0) continue;
+        
+        int i = attribute_count++;
+        instance_attributes[i] = attribute.location;
+        glVertexAttribPointer(instance_attributes[i], attribute.components, GL_FLOAT, false, sizeof(SpriteInstance),
+                              (const void *) attribute.offset);
+        glEnableVertexAttribArray(instance_attributes[i]);
+        g_gl_extensions.vertex_attrib_divisor(instance_attributes[i], 1);
+    }
+    
+    g_gl_extensions.draw_elements_instanced(GL_TRIANGLES, INDICES_PER_QUAD, GL_UNSIGNED_SHORT, nullptr,
+                                            group.get_instance_count());
+    
+    // Divisors are sticky per attribute location and would break the next non-instanced draw
+    for (int i = 0; i < attribute_count; i++)
+    {
+        g_gl_extensions.vertex_attrib_divisor(instance_attributes[i], 0);
+        glDisableVertexAttribArray(instance_attributes[i]);
+    }
+    glDisableVertexAttribArray(instanced_program->get_position_attribute());
+    glDisableVertexAttribArray(instanced_program->get_tex_coordinate_attribute());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    
+    m_program->use();
+    if (was_bound) begin();
+}
+
+void SpriteInstanceGroup::set_instances(GLuint texture_id, const std::vector<SpriteInstance> &instances,
+                                        unsigned int source_revision)
+{
+    m_texture_id      = texture_id;
+    m_instances       = instances;
+    m_source_revision = source_revision;
+    
+    if (m_instance_buffer == 0) glGenBuffers(1, &m_instance_buffer);
+    
+    glBindBuffer(GL_ARRAY_BUFFER, m_instance_buffer);
+    glBufferData(GL_ARRAY_BUFFER, m_instances.size() * sizeof(SpriteInstance), m_instances.data(),
+                 GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void SpriteInstanceGroup::cleanup()
+{
+    glDeleteBuffers(1, &m_instance_buffer);
+    m_instance_buffer = 0;
+    m_instances.clear();
+}
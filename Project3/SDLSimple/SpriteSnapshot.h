@@ -0,0 +1,20 @@
+#pragma once
+
+#ifdef _WINDOWS
+    #include <GL/glew.h>
+#endif
+#define GL_GLEXT_PROTOTYPES 1
+#include <SDL_opengl.h>
+#include "glm/vec4.hpp"
+#include "Transform2D.h"
+
+// Everything needed to draw a sprite, copied out of its entity so the renderer never reads
+// state the simulation may be changing
+struct SpriteSnapshot
+{
+    Transform2D transform;
+    glm::vec4   uv_rect    = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+    GLuint      texture_id = 0;
+    float       depth      = 0.0f;
+    bool        opaque     = false;
+};
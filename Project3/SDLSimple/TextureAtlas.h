@@ -0,0 +1,87 @@
+#pragma once
+
+#ifdef _WINDOWS
+    #include <GL/glew.h>
+#endif
+#define GL_GLEXT_PROTOTYPES 1
+#include <SDL_opengl.h>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+#include "glm/vec4.hpp"
+#include "Image.h"
+#include "TextureManager.h"
+#include "AssetLoader.h"
+
+// Where a sprite ended up: the page texture plus its UV sub-rectangle (u, v, width, height)
+struct AtlasRegion
+{
+    GLuint    texture_id = 0;
+    glm::vec4 uv_rect    = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+    bool      opaque     = false;
+};
+
+class TextureAtlas
+{
+private:
+    struct SkylineNode
+    {
+        int x, y, width;
+    };
+
+    struct Page
+    {
+        std::vector<SkylineNode> skyline;
+        Image  image;
+        int    used_width  = 0;
+        int    used_height = 0;
+        GLuint texture_id  = 0;
+    };
+
+    struct PendingImage
+    {
+        std::string path;
+        int max_width, max_height;
+    };
+
+    struct Placement
+    {
+        std::string path;
+        int page, x, y, width, height;
+    };
+
+    bool find_position(const Page &page, int width, int height, int &best_x, int &best_y, int &best_node) const;
+    void insert_skyline(Page &page, int node, int x, int y, int width, int height);
+    bool pack(Page &page, int width, int height, int &x, int &y);
+    void blit(Page &page, const Image &image, int x, int y);
+
+    std::vector<PendingImage>          m_pending;
+    std::vector<Page>                  m_pages;
+    std::map<std::string, AtlasRegion> m_regions;
+
+    int         m_page_size      = PAGE_SIZE;
+    std::size_t m_resident_bytes = 0;
+
+public:
+    // ————— STATIC VARIABLES ————— //
+    static constexpr int PAGE_SIZE = 4096;
+    // Each sprite's edge pixels are repeated into this border so filtering never samples a neighbour
+    static constexpr int PADDING    = 4;
+    // Every mip level halves the border, so the chain stops while at least one texel of it survives
+    static constexpr int MIP_LEVELS = 3;
+
+    // ————— METHODS ————— //
+    // Sprites larger than max_width x max_height are shrunk before packing (0 = no limit)
+    void add(const char *filepath, int max_width = 0, int max_height = 0);
+    // Decodes everything added so far (in parallel when given a running loader), packs it with
+    // a skyline bottom-left heuristic and uploads the pages
+    void build(FilterType filter_type, AssetLoader *loader = nullptr);
+    void cleanup();
+
+    // ————— GETTERS ————— //
+    bool        const contains(const char *filepath) const { return m_regions.count(filepath) > 0; }
+    AtlasRegion const get_region(const char *filepath) const;
+    int         const get_page_count()     const { return (int) m_pages.size(); }
+    std::size_t const get_resident_bytes() const { return m_resident_bytes;     }
+};
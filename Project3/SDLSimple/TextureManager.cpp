@@ -0,0 +1,310 @@
+#define GL_SILENCE_DEPRECATION
+
+#include "TextureManager.h"
+#include "TextureUploader.h"
+#include "GLExtensions.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+constexpr GLint NUMBER_OF_TEXTURES = 1,
+                LEVEL_OF_DETAIL    = 0,
+                TEXTURE_BORDER     = 0;
+
+// Filtering and wrapping for the texture currently bound to GL_TEXTURE_2D
+static void set_sampling(const TextureOptions &options, bool mipmapped)
+{
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+                    options.filter_type == NEAREST ? (mipmapped ? GL_NEAREST_MIPMAP_NEAREST : GL_NEAREST)
+                                                   : (mipmapped ? GL_LINEAR_MIPMAP_LINEAR   : GL_LINEAR));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER,
+                    options.filter_type == NEAREST ? GL_NEAREST : GL_LINEAR);
+    
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, options.wrap_mode);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, options.wrap_mode);
+}
+
+GLuint TextureManager::acquire(const char *filepath, FilterType filter_type)
+{
+    TextureOptions options;
+    options.filter_type = filter_type;
+    return acquire(filepath, options);
+}
+
+GLuint TextureManager::acquire(const char *filepath, const TextureOptions &options)
+{
+    std::string key = make_key(filepath, options);
+    
+    auto found = m_textures.find(key);
+    if (found != m_textures.end())
+    {
+        found->second.ref_count++;
+        return found->second.texture_id;
+    }
+    
+    std::size_t byte_size = 0;
+    GLuint texture_id;
+    bool opaque;
+    
+    KtxTexture compressed;
+    AssetArchive::Texture cooked;
+    if (has_compressed(filepath) && compressed.load(KtxTexture::path_for(filepath).c_str()))
+    {
+        texture_id = create_texture(compressed, options, &byte_size);
+        // Decoding blocks just to check would defeat the point; only BC1 without alpha is known opaque
+        opaque     = compressed.get_vk_format() == KTX_BC1_RGB_UNORM;
+    }
+    else if (m_archive != nullptr && m_archive->find(filepath, cooked))
+    {
+        // The cooked chain already holds every level; skip the ones larger than the texture is drawn
+        int first_level = cooked.get_level_to_fit(options.max_width, options.max_height),
+            level_count = std::min(cooked.get_level_count() - first_level, options.max_mip_levels);
+        
+        std::vector<ImageView> levels;
+        for (int level = 0; level < level_count; level++) levels.push_back(cooked.get_level(first_level + level));
+        
+        texture_id = create_texture(levels.data(), level_count, options, &byte_size);
+        opaque     = ::is_opaque(levels[0]);
+    }
+    else
+    {
+        Image image;
+        auto pending = m_pending.find(key);
+        if (pending != m_pending.end())
+        {
+            image = pending->second.get();
+            m_pending.erase(pending);
+        }
+        else if (load_image(filepath, image))
+        {
+            downscale_to_fit(image, options.max_width, options.max_height);
+        }
+        
+        // Nothing is cached for a failed load, so a later acquire() tries the file again
+        assert(image.width != 0);
+        if (image.width == 0)
+        {
+            std::cout << "Texture " << filepath << " could not be decoded, nothing was uploaded." << std::endl;
+            return 0;
+        }
+        
+        texture_id = create_texture(image, options, &byte_size);
+        opaque     = ::is_opaque(image.view());
+    }
+    
+    m_textures[key]          = { texture_id, 1, byte_size, opaque };
+    m_keys_by_id[texture_id] = key;
+    m_resident_bytes        += byte_size;
+    
+    return texture_id;
+}
+
+void TextureManager::prefetch(const char *filepath, const TextureOptions &options)
+{
+    if (m_loader == nullptr) return;
+    
+    std::string key = make_key(filepath, options);
+    if (m_textures.count(key) > 0 || m_pending.count(key) > 0 || m_without_decode.count(filepath) > 0) return;
+    
+    // Nothing to decode: acquire() uploads the compressed file or straight from the archive mapping
+    AssetArchive::Texture cooked;
+    if (has_compressed(filepath) || (m_archive != nullptr && m_archive->find(filepath, cooked)))
+    {
+        m_without_decode.insert(filepath);
+        return;
+    }
+    
+    m_pending[key] = m_loader->decode(filepath, options.max_width, options.max_height);
+}
+
+bool TextureManager::is_ready(const char *filepath, const TextureOptions &options) const
+{
+    std::string key = make_key(filepath, options);
+    if (m_textures.count(key) > 0 || m_without_decode.count(filepath) > 0) return true;
+    
+    AssetArchive::Texture cooked;
+    if (has_compressed(filepath) || (m_archive != nullptr && m_archive->find(filepath, cooked))) return true;
+    
+    auto pending = m_pending.find(key);
+    return pending != m_pending.end() &&
+           pending->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+std::map<std::string, bool> TextureManager::s_compressed_paths;
+
+std::string TextureManager::make_key(const char *filepath, const TextureOptions &options)
+{
+    return std::string(filepath) + (options.filter_type == NEAREST ? "#nearest" : "#linear")
+        + "#" + std::to_string(options.wrap_mode)
+        + "#" + std::to_string(options.max_width) + "x" + std::to_string(options.max_height)
+        + "#" + std::to_string(options.max_mip_levels);
+}
+
+void TextureManager::release(GLuint texture_id)
+{
+    auto key = m_keys_by_id.find(texture_id);
+    if (key == m_keys_by_id.end()) return;
+    
+    TextureRecord &record = m_textures[key->second];
+    if (--record.ref_count > 0) return;
+    
+    glDeleteTextures(NUMBER_OF_TEXTURES, &record.texture_id);
+    m_resident_bytes -= record.byte_size;
+    
+    m_textures.erase(key->second);
+    m_keys_by_id.erase(key);
+}
+
+void TextureManager::release_all()
+{
+    // Let in-flight decodes finish before their destination goes away
+    for (auto &pending : m_pending) pending.second.wait();
+    m_pending.clear();
+    
+    for (auto &entry : m_textures) glDeleteTextures(NUMBER_OF_TEXTURES, &entry.second.texture_id);
+    
+    m_textures.clear();
+    m_keys_by_id.clear();
+    m_resident_bytes = 0;
+}
+
+int const TextureManager::get_ref_count(GLuint texture_id) const
+{
+    auto key = m_keys_by_id.find(texture_id);
+    if (key == m_keys_by_id.end()) return 0;
+    
+    return m_textures.at(key->second).ref_count;
+}
+
+bool const TextureManager::is_opaque(GLuint texture_id) const
+{
+    auto key = m_keys_by_id.find(texture_id);
+    if (key == m_keys_by_id.end()) return false;
+    
+    return m_textures.at(key->second).opaque;
+}
+
+GLuint TextureManager::create_texture(const Image &image, const TextureOptions &options, std::size_t *byte_size)
+{
+    std::vector<Image> mips;
+    build_mip_chain(image, mips, options.max_mip_levels);
+    
+    std::vector<ImageView> levels = { image.view() };
+    for (const Image &mip : mips) levels.push_back(mip.view());
+    
+    return create_texture(levels.data(), (int) levels.size(), options, byte_size);
+}
+
+GLuint TextureManager::create_texture(const ImageView *levels, int level_count, const TextureOptions &options,
+                                      std::size_t *byte_size)
+{
+    GLuint textureID;
+    std::size_t total_bytes = 0;
+    for (int level = 0; level < level_count; level++)
+        total_bytes += (std::size_t) levels[level].width * levels[level].height * Image::BYTES_PER_PIXEL;
+    
+    if (g_texture_uploader.is_initialised())
+    {
+        // Storage is allocated once and every level streams through the unpack buffer ring
+        textureID = g_texture_uploader.allocate(levels[0].width, levels[0].height, level_count);
+        for (int level = 0; level < level_count; level++)
+            g_texture_uploader.upload(textureID, LEVEL_OF_DETAIL + level, levels[level]);
+        
+        glBindTexture(GL_TEXTURE_2D, textureID);
+    }
+    else
+    {
+        glGenTextures(NUMBER_OF_TEXTURES, &textureID);
+        glBindTexture(GL_TEXTURE_2D, textureID);
+        
+        for (int level = 0; level < level_count; level++)
+        {
+            glTexImage2D(GL_TEXTURE_2D, LEVEL_OF_DETAIL + level, GL_RGBA, levels[level].width, levels[level].height,
+                         TEXTURE_BORDER, GL_RGBA, GL_UNSIGNED_BYTE, levels[level].pixels);
+        }
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, level_count - 1);
+    }
+    
+    set_sampling(options, level_count > 1);
+    
+    if (byte_size != nullptr) *byte_size = total_bytes;
+    
+    return textureID;
+}
+
+GLuint TextureManager::create_texture(const KtxTexture &texture, const TextureOptions &options, std::size_t *byte_size)
+{
+    GLenum internal_format = texture.get_vk_format() == KTX_BC3_UNORM      ? GL_COMPRESSED_RGBA_S3TC_DXT5_EXT :
+                             texture.get_vk_format() == KTX_BC1_RGBA_UNORM ? GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+                                                                           : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+    
+    int first_level = texture.get_level_to_fit(options.max_width, options.max_height),
+        level_count = std::min(texture.get_level_count() - first_level, options.max_mip_levels);
+    
+    GLuint textureID;
+    glGenTextures(NUMBER_OF_TEXTURES, &textureID);
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    
+    std::size_t total_bytes = 0;
+    for (int level = 0; level < level_count; level++)
+    {
+        KtxTexture::Level source = texture.get_level(first_level + level);
+        glCompressedTexImage2D(GL_TEXTURE_2D, LEVEL_OF_DETAIL + level, internal_format, source.width, source.height,
+                               TEXTURE_BORDER, (GLsizei) source.byte_size, source.data);
+        total_bytes += source.byte_size;
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, level_count - 1);
+    
+    set_sampling(options, level_count > 1);
+    
+    if (byte_size != nullptr) *byte_size = total_bytes;
+    
+    return textureID;
+}
+
+bool TextureManager::has_compressed(const char *filepath)
+{
+    if (!g_gl_extensions.texture_compression_s3tc) return false;
+    
+    auto found = s_compressed_paths.find(filepath);
+    if (found != s_compressed_paths.end()) return found->second;
+    
+    std::ifstream file(KtxTexture::path_for(filepath));
+    return s_compressed_paths[filepath] = file.good();
+}
+
+void LazyTexture::set_source(TextureManager *manager, const char *filepath, const TextureOptions &options)
+{
+    release();
+    
+    m_manager  = manager;
+    m_filepath = filepath;
+    m_options  = options;
+}
+
+void LazyTexture::prefetch()
+{
+    if (m_texture_id == 0) m_manager->prefetch(m_filepath.c_str(), m_options);
+}
+
+GLuint LazyTexture::get()
+{
+    if (m_texture_id == 0) m_texture_id = m_manager->acquire(m_filepath.c_str(), m_options);
+    return m_texture_id;
+}
+
+void LazyTexture::release()
+{
+    if (m_texture_id == 0) return;
+    
+    m_manager->release(m_texture_id);
+    m_texture_id = 0;
+}
+
+bool const LazyTexture::is_ready() const
+{
+    return m_texture_id != 0 || m_manager->is_ready(m_filepath.c_str(), m_options);
+}
@@ -0,0 +1,101 @@
+#define GL_SILENCE_DEPRECATION
+
+#include "TextureUploader.h"
+#include "GLExtensions.h"
+#include <algorithm>
+#include <cstring>
+
+TextureUploader g_texture_uploader;
+
+void TextureUploader::initialise(int ring_size)
+{
+    m_ring.resize(ring_size);
+    for (StagingBuffer &staging : m_ring) glGenBuffers(1, &staging.buffer_id);
+    m_next = 0;
+}
+
+void TextureUploader::cleanup()
+{
+    for (StagingBuffer &staging : m_ring) glDeleteBuffers(1, &staging.buffer_id);
+    m_ring.clear();
+    m_mapped = -1;
+}
+
+GLuint TextureUploader::allocate(int width, int height, int levels)
+{
+    GLuint texture_id;
+    glGenTextures(1, &texture_id);
+    glBindTexture(GL_TEXTURE_2D, texture_id);
+    
+    if (g_gl_extensions.texture_storage)
+    {
+        g_gl_extensions.tex_storage_2d(GL_TEXTURE_2D, levels, GL_RGBA8, width, height);
+        return texture_id;
+    }
+    
+    for (int level = 0; level < levels; level++)
+    {
+        glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        width  = width  > 1 ? width  / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+    
+    return texture_id;
+}
+
+unsigned char* TextureUploader::map(std::size_t byte_size)
+{
+    m_mapped = m_next;
+    m_next   = (m_next + 1) % (int) m_ring.size();
+    
+    StagingBuffer &staging = m_ring[m_mapped];
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, staging.buffer_id);
+    
+    // Re-specifying the store orphans whatever a previous upload may still be reading,
+    // so the map below never waits for the GPU
+    staging.capacity = std::max(staging.capacity, byte_size);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, staging.capacity, nullptr, GL_STREAM_DRAW);
+    
+    unsigned char *pixels = (unsigned char *) glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    
+    return pixels;
+}
+
+void TextureUploader::unmap_and_upload(GLuint texture_id, int level, int width, int height)
+{
+    if (m_mapped < 0) return;
+    
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_ring[m_mapped].buffer_id);
+    
+    if (glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_TRUE)
+    {
+        // With an unpack buffer bound, the data pointer is an offset into it
+        glBindTexture(GL_TEXTURE_2D, texture_id);
+        glTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        m_bytes_uploaded += (std::size_t) width * height * Image::BYTES_PER_PIXEL;
+    }
+    
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    m_mapped = -1;
+}
+
+void TextureUploader::upload(GLuint texture_id, int level, const ImageView &image)
+{
+    std::size_t byte_size = (std::size_t) image.width * image.height * Image::BYTES_PER_PIXEL;
+    unsigned char *pixels = map(byte_size);
+    
+    if (pixels == nullptr)
+    {
+        // Mapping can fail under memory pressure; fall back to a client-memory upload
+        m_mapped = -1;
+        glBindTexture(GL_TEXTURE_2D, texture_id);
+        glTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, image.width, image.height, GL_RGBA, GL_UNSIGNED_BYTE,
+                        image.pixels);
+        return;
+    }
+    
+    std::memcpy(pixels, image.pixels, byte_size);
+    unmap_and_upload(texture_id, level, image.width, image.height);
+}
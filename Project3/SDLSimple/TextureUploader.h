@@ -0,0 +1,59 @@
+#pragma once
+
+#ifdef _WINDOWS
+    #include <GL/glew.h>
+#endif
+#define GL_GLEXT_PROTOTYPES 1
+#include <SDL_opengl.h>
+#include <cstddef>
+#include <vector>
+#include "Image.h"
+
+// Streams texel data through a ring of pixel unpack buffers. glTexSubImage2D then
+// reads from GPU-visible memory and returns immediately, instead of the driver
+// copying out of client memory while the CPU waits. Decoded images still get one
+// copy into the mapping: decoding runs on worker threads before any buffer is mapped
+class TextureUploader
+{
+private:
+    struct StagingBuffer
+    {
+        GLuint      buffer_id = 0;
+        std::size_t capacity  = 0;
+    };
+
+    std::vector<StagingBuffer> m_ring;
+    int m_next = 0;
+
+    // The buffer handed out by map() until the matching unmap_and_upload()
+    int m_mapped = -1;
+
+    std::size_t m_bytes_uploaded = 0;
+
+public:
+    // ————— STATIC VARIABLES ————— //
+    static constexpr int RING_SIZE = 3;
+
+    // ————— METHODS ————— //
+    void initialise(int ring_size = RING_SIZE);
+    void cleanup();
+
+    // Creates a texture with all its levels allocated up front, as immutable
+    // storage when the context supports it
+    GLuint allocate(int width, int height, int levels);
+
+    // Maps the next staging buffer so a decoder can write texels straight into it.
+    // Mapping and unmapping must happen on the GL thread; filling may happen anywhere
+    unsigned char* map(std::size_t byte_size);
+    void unmap_and_upload(GLuint texture_id, int level, int width, int height);
+
+    // map() + copy + unmap_and_upload() for pixels that are already decoded, which is every
+    // caller today; the copy stands in for the one the driver would otherwise make synchronously
+    void upload(GLuint texture_id, int level, const ImageView &image);
+
+    // ————— GETTERS ————— //
+    bool        const is_initialised()     const { return !m_ring.empty();   }
+    std::size_t const get_bytes_uploaded() const { return m_bytes_uploaded; }
+};
+
+extern TextureUploader g_texture_uploader;
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Hands the newest value from one writer thread to one reader thread without locks or waiting.
+// The writer fills back() and publishes it; the reader picks up whatever was published last,
+// skipping any it never got round to. Neither side ever touches the slot the other is using
+template <typename T>
+class TripleBuffer
+{
+private:
+    // The shared index carries the middle slot plus a flag saying it holds something unread
+    static constexpr uint8_t INDEX_MASK = 0x3,
+                             FRESH_BIT  = 0x4;
+
+    T m_slots[3];
+
+    std::atomic<uint8_t> m_middle { 1 };
+    uint8_t              m_back  = 0; // owned by the writer
+    uint8_t              m_front = 2; // owned by the reader
+
+public:
+    // ————— WRITER ————— //
+    T &back() { return m_slots[m_back]; }
+
+    void publish()
+    {
+        m_back = m_middle.exchange(m_back | FRESH_BIT, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    // ————— READER ————— //
+    // True if something newer than front() was published since the last call
+    bool acquire()
+    {
+        if ((m_middle.load(std::memory_order_relaxed) & FRESH_BIT) == 0) return false;
+
+        m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+
+    const T &front() const { return m_slots[m_front]; }
+};
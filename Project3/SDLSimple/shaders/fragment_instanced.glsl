@@ -0,0 +1,8 @@
+
+uniform sampler2D diffuse;
+varying vec2 texCoordVar;
+varying vec4 tintVar;
+
+void main() {
+    gl_FragColor = texture2D(diffuse, texCoordVar) * tintVar;
+}
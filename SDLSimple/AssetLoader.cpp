@@ -0,0 +1,80 @@
+#include "AssetLoader.h"
+#include <memory>
+
+void AssetLoader::start(int thread_count)
+{
+    if (is_running()) return;
+    
+    if (thread_count <= 0) thread_count = (int) std::thread::hardware_concurrency();
+    if (thread_count <= 0) thread_count = 2;
+    
+    m_stopping = false;
+    for (int i = 0; i < thread_count; i++) m_workers.emplace_back(&AssetLoader::worker_loop, this);
+}
+
+void AssetLoader::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_job_available.notify_all();
+    
+    for (std::thread &worker : m_workers) worker.join();
+    m_workers.clear();
+}
+
+std::future<Image> AssetLoader::decode(const std::string &filepath, int max_width, int max_height)
+{
+    const AssetArchive *archive = m_archive;
+    auto job = std::make_shared<std::packaged_task<Image()>>([filepath, max_width, max_height, archive]()
+    {
+        Image image;
+        AssetArchive::Texture cooked;
+        if (archive != nullptr && archive->find(filepath.c_str(), cooked))
+        {
+            // Start from the smallest cooked level that still covers the requested size
+            ImageView level = cooked.get_level(cooked.get_level_to_fit(max_width, max_height));
+            image.width  = level.width;
+            image.height = level.height;
+            image.pixels.assign(level.pixels, level.pixels + (std::size_t) level.width * level.height * Image::BYTES_PER_PIXEL);
+            downscale_to_fit(image, max_width, max_height);
+        }
+        else if (load_image(filepath.c_str(), image)) downscale_to_fit(image, max_width, max_height);
+        return image;
+    });
+    std::future<Image> result = job->get_future();
+    
+    // Without workers the caller still gets a ready future, just decoded inline
+    if (!is_running())
+    {
+        (*job)();
+        return result;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.push_back([job]() { (*job)(); });
+    }
+    m_job_available.notify_one();
+    
+    return result;
+}
+
+void AssetLoader::worker_loop()
+{
+    while (true)
+    {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_job_available.wait(lock, [this]() { return m_stopping || !m_jobs.empty(); });
+            
+            if (m_jobs.empty()) return;
+            
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+        job();
+    }
+}
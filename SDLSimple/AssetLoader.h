@@ -0,0 +1,47 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Image.h"
+#include "AssetArchive.h"
+
+// Worker pool that decodes (and downscales) images off the GL thread. Only the
+// decoded pixels come back; uploading stays with whoever owns the context
+class AssetLoader
+{
+private:
+    void worker_loop();
+
+    std::vector<std::thread>          m_workers;
+    std::deque<std::function<void()>> m_jobs;
+    std::mutex                        m_mutex;
+    std::condition_variable           m_job_available;
+
+    bool m_stopping = false;
+
+    const AssetArchive *m_archive = nullptr;
+
+public:
+    ~AssetLoader() { stop(); }
+
+    // 0 picks one worker per hardware thread
+    void start(int thread_count = 0);
+    // Finishes the jobs already queued, then joins the workers
+    void stop();
+
+    // Archived images are copied out of the mapping instead of being decoded
+    void set_archive(const AssetArchive *archive) { m_archive = archive; }
+
+    // A failed decode yields an empty Image (width 0)
+    std::future<Image> decode(const std::string &filepath, int max_width = 0, int max_height = 0);
+
+    // ————— GETTERS ————— //
+    bool const is_running()       const { return !m_workers.empty(); }
+    int  const get_thread_count() const { return (int) m_workers.size(); }
+};
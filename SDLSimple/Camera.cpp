@@ -0,0 +1,54 @@
+#define GL_SILENCE_DEPRECATION
+
+#include "Camera.h"
+#include "GLExtensions.h"
+#include <cstddef>
+
+void Camera::initialise()
+{
+    if (!g_gl_extensions.uniform_buffer_object) return;
+    
+    glGenBuffers(1, &m_uniform_buffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, m_uniform_buffer);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(UniformBlock), &m_block, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    
+    g_gl_extensions.bind_buffer_base(GL_UNIFORM_BUFFER, BINDING_POINT, m_uniform_buffer);
+}
+
+void Camera::cleanup()
+{
+    glDeleteBuffers(1, &m_uniform_buffer);
+    m_uniform_buffer = 0;
+}
+
+void Camera::set_view_matrix(const glm::mat4 &matrix)
+{
+    if (m_block.view_matrix == matrix) return;
+    
+    m_block.view_matrix = matrix;
+    m_revision++;
+    
+    if (uses_uniform_buffer())
+    {
+        glBindBuffer(GL_UNIFORM_BUFFER, m_uniform_buffer);
+        glBufferSubData(GL_UNIFORM_BUFFER, offsetof(UniformBlock, view_matrix), sizeof(glm::mat4), &matrix[0][0]);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+}
+
+void Camera::set_projection_matrix(const glm::mat4 &matrix)
+{
+    if (m_block.projection_matrix == matrix) return;
+    
+    m_block.projection_matrix = matrix;
+    m_revision++;
+    
+    if (uses_uniform_buffer())
+    {
+        glBindBuffer(GL_UNIFORM_BUFFER, m_uniform_buffer);
+        glBufferSubData(GL_UNIFORM_BUFFER, offsetof(UniformBlock, projection_matrix), sizeof(glm::mat4),
+                        &matrix[0][0]);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+}
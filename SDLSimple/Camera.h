@@ -0,0 +1,46 @@
+#pragma once
+
+#ifdef _WINDOWS
+    #include <GL/glew.h>
+#endif
+#define GL_GLEXT_PROTOTYPES 1
+#include <SDL_opengl.h>
+#include "glm/mat4x4.hpp"
+
+// View and projection shared by every ShaderProgram. With uniform buffers a change is a
+// single buffer write that all programs see; without them each program compares the
+// revision when it is next bound and re-uploads only if the camera moved since
+class Camera
+{
+private:
+    // std140 lays a mat4 out as four vec4 columns, which is exactly glm's layout
+    struct UniformBlock
+    {
+        glm::mat4 view_matrix;
+        glm::mat4 projection_matrix;
+    };
+
+    UniformBlock m_block = { glm::mat4(1.0f), glm::mat4(1.0f) };
+
+    // Programs start at revision 0, so a fresh program always syncs once
+    unsigned int m_revision = 1;
+
+    GLuint m_uniform_buffer = 0;
+
+public:
+    // ————— STATIC VARIABLES ————— //
+    static constexpr GLuint BINDING_POINT = 0;
+
+    // ————— METHODS ————— //
+    void initialise();
+    void cleanup();
+
+    void set_view_matrix(const glm::mat4 &matrix);
+    void set_projection_matrix(const glm::mat4 &matrix);
+
+    // ————— GETTERS ————— //
+    glm::mat4    const &get_view_matrix()       const { return m_block.view_matrix;       }
+    glm::mat4    const &get_projection_matrix() const { return m_block.projection_matrix; }
+    unsigned int const  get_revision()          const { return m_revision;                }
+    bool         const  uses_uniform_buffer()   const { return m_uniform_buffer != 0;     }
+};
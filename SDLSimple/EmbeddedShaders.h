@@ -0,0 +1,200 @@
+#pragma once
+
+// Generated by tools/embed_files.py (the Embed Shaders build phase); do not edit.
+
+#include <cstddef>
+#include <cstring>
+
+struct EmbeddedFile
+{
+    const char *path;
+    const char *data;
+    std::size_t size;
+};
+
+// shaders/fragment.glsl
+constexpr char SHADERS_FRAGMENT_GLSL[] = {
+    0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x63, 0x6f, 0x6c,
+    0x6f, 0x72, 0x3b, 0x0a, 0x0a, 0x76, 0x6f, 0x69, 0x64, 0x20, 0x6d, 0x61, 0x69, 0x6e, 0x28, 0x29,
+    0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x67, 0x6c, 0x5f, 0x46, 0x72, 0x61, 0x67, 0x43, 0x6f,
+    0x6c, 0x6f, 0x72, 0x20, 0x3d, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x0a, 0x7d, 0x0a, 0x00,
+};
+
+// shaders/fragment_instanced.glsl
+constexpr char SHADERS_FRAGMENT_INSTANCED_GLSL[] = {
+    0x0a, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72,
+    0x32, 0x44, 0x20, 0x64, 0x69, 0x66, 0x66, 0x75, 0x73, 0x65, 0x3b, 0x0a, 0x76, 0x61, 0x72, 0x79,
+    0x69, 0x6e, 0x67, 0x20, 0x76, 0x65, 0x63, 0x32, 0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72,
+    0x64, 0x56, 0x61, 0x72, 0x3b, 0x0a, 0x76, 0x61, 0x72, 0x79, 0x69, 0x6e, 0x67, 0x20, 0x76, 0x65,
+    0x63, 0x34, 0x20, 0x74, 0x69, 0x6e, 0x74, 0x56, 0x61, 0x72, 0x3b, 0x0a, 0x0a, 0x76, 0x6f, 0x69,
+    0x64, 0x20, 0x6d, 0x61, 0x69, 0x6e, 0x28, 0x29, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x67,
+    0x6c, 0x5f, 0x46, 0x72, 0x61, 0x67, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x20, 0x3d, 0x20, 0x74, 0x65,
+    0x78, 0x74, 0x75, 0x72, 0x65, 0x32, 0x44, 0x28, 0x64, 0x69, 0x66, 0x66, 0x75, 0x73, 0x65, 0x2c,
+    0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x56, 0x61, 0x72, 0x29, 0x20, 0x2a, 0x20,
+    0x74, 0x69, 0x6e, 0x74, 0x56, 0x61, 0x72, 0x3b, 0x0a, 0x7d, 0x0a, 0x00,
+};
+
+// shaders/fragment_textured.glsl
+constexpr char SHADERS_FRAGMENT_TEXTURED_GLSL[] = {
+    0x0a, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72,
+    0x32, 0x44, 0x20, 0x64, 0x69, 0x66, 0x66, 0x75, 0x73, 0x65, 0x3b, 0x0a, 0x76, 0x61, 0x72, 0x79,
+    0x69, 0x6e, 0x67, 0x20, 0x76, 0x65, 0x63, 0x32, 0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72,
+    0x64, 0x56, 0x61, 0x72, 0x3b, 0x0a, 0x0a, 0x76, 0x6f, 0x69, 0x64, 0x20, 0x6d, 0x61, 0x69, 0x6e,
+    0x28, 0x29, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x67, 0x6c, 0x5f, 0x46, 0x72, 0x61, 0x67,
+    0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x20, 0x3d, 0x20, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x32,
+    0x44, 0x28, 0x64, 0x69, 0x66, 0x66, 0x75, 0x73, 0x65, 0x2c, 0x20, 0x74, 0x65, 0x78, 0x43, 0x6f,
+    0x6f, 0x72, 0x64, 0x56, 0x61, 0x72, 0x29, 0x3b, 0x0a, 0x7d, 0x0a, 0x00,
+};
+
+// shaders/vertex.glsl
+constexpr char SHADERS_VERTEX_GLSL[] = {
+    0x61, 0x74, 0x74, 0x72, 0x69, 0x62, 0x75, 0x74, 0x65, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x70,
+    0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x0a, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72,
+    0x6d, 0x20, 0x6d, 0x61, 0x74, 0x34, 0x20, 0x6d, 0x6f, 0x64, 0x65, 0x6c, 0x4d, 0x61, 0x74, 0x72,
+    0x69, 0x78, 0x3b, 0x0a, 0x0a, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x43, 0x41, 0x4d, 0x45,
+    0x52, 0x41, 0x5f, 0x55, 0x4e, 0x49, 0x46, 0x4f, 0x52, 0x4d, 0x5f, 0x42, 0x55, 0x46, 0x46, 0x45,
+    0x52, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x28, 0x73, 0x74, 0x64, 0x31, 0x34, 0x30, 0x29,
+    0x20, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x43, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x0a,
+    0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x6d, 0x61, 0x74, 0x34, 0x20, 0x76, 0x69, 0x65, 0x77, 0x4d,
+    0x61, 0x74, 0x72, 0x69, 0x78, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x6d, 0x61, 0x74, 0x34, 0x20,
+    0x70, 0x72, 0x6f, 0x6a, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x4d, 0x61, 0x74, 0x72, 0x69, 0x78,
+    0x3b, 0x0a, 0x7d, 0x3b, 0x0a, 0x23, 0x65, 0x6c, 0x73, 0x65, 0x0a, 0x75, 0x6e, 0x69, 0x66, 0x6f,
+    0x72, 0x6d, 0x20, 0x6d, 0x61, 0x74, 0x34, 0x20, 0x76, 0x69, 0x65, 0x77, 0x4d, 0x61, 0x74, 0x72,
+    0x69, 0x78, 0x3b, 0x0a, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x6d, 0x61, 0x74, 0x34,
+    0x20, 0x70, 0x72, 0x6f, 0x6a, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x4d, 0x61, 0x74, 0x72, 0x69,
+    0x78, 0x3b, 0x0a, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x0a, 0x76, 0x6f, 0x69, 0x64, 0x20,
+    0x6d, 0x61, 0x69, 0x6e, 0x28, 0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x34, 0x20, 0x70,
+    0x20, 0x3d, 0x20, 0x76, 0x69, 0x65, 0x77, 0x4d, 0x61, 0x74, 0x72, 0x69, 0x78, 0x20, 0x2a, 0x20,
+    0x6d, 0x6f, 0x64, 0x65, 0x6c, 0x4d, 0x61, 0x74, 0x72, 0x69, 0x78, 0x20, 0x20, 0x2a, 0x20, 0x70,
+    0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x09, 0x67, 0x6c, 0x5f, 0x50, 0x6f, 0x73,
+    0x69, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x70, 0x72, 0x6f, 0x6a, 0x65, 0x63, 0x74, 0x69,
+    0x6f, 0x6e, 0x4d, 0x61, 0x74, 0x72, 0x69, 0x78, 0x20, 0x2a, 0x20, 0x70, 0x3b, 0x0a, 0x7d, 0x0a,
+    0x00,
+};
+
+// shaders/vertex_instanced.glsl
+constexpr char SHADERS_VERTEX_INSTANCED_GLSL[] = {
+    0x61, 0x74, 0x74, 0x72, 0x69, 0x62, 0x75, 0x74, 0x65, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x70,
+    0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x61, 0x74, 0x74, 0x72, 0x69, 0x62, 0x75,
+    0x74, 0x65, 0x20, 0x76, 0x65, 0x63, 0x32, 0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64,
+    0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x50, 0x65, 0x72, 0x2d, 0x69, 0x6e, 0x73, 0x74, 0x61, 0x6e,
+    0x63, 0x65, 0x20, 0x61, 0x74, 0x74, 0x72, 0x69, 0x62, 0x75, 0x74, 0x65, 0x73, 0x2c, 0x20, 0x61,
+    0x64, 0x76, 0x61, 0x6e, 0x63, 0x65, 0x64, 0x20, 0x6f, 0x6e, 0x63, 0x65, 0x20, 0x70, 0x65, 0x72,
+    0x20, 0x73, 0x70, 0x72, 0x69, 0x74, 0x65, 0x20, 0x72, 0x61, 0x74, 0x68, 0x65, 0x72, 0x20, 0x74,
+    0x68, 0x61, 0x6e, 0x20, 0x70, 0x65, 0x72, 0x20, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x0a, 0x61,
+    0x74, 0x74, 0x72, 0x69, 0x62, 0x75, 0x74, 0x65, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x69, 0x6e,
+    0x73, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x4c, 0x69, 0x6e, 0x65, 0x61, 0x72, 0x3b, 0x0a, 0x61, 0x74,
+    0x74, 0x72, 0x69, 0x62, 0x75, 0x74, 0x65, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x69, 0x6e, 0x73,
+    0x74, 0x61, 0x6e, 0x63, 0x65, 0x54, 0x72, 0x61, 0x6e, 0x73, 0x6c, 0x61, 0x74, 0x69, 0x6f, 0x6e,
+    0x3b, 0x0a, 0x61, 0x74, 0x74, 0x72, 0x69, 0x62, 0x75, 0x74, 0x65, 0x20, 0x76, 0x65, 0x63, 0x34,
+    0x20, 0x69, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x55, 0x76, 0x52, 0x65, 0x63, 0x74, 0x3b,
+    0x0a, 0x61, 0x74, 0x74, 0x72, 0x69, 0x62, 0x75, 0x74, 0x65, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20,
+    0x69, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x54, 0x69, 0x6e, 0x74, 0x3b, 0x0a, 0x0a, 0x23,
+    0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x43, 0x41, 0x4d, 0x45, 0x52, 0x41, 0x5f, 0x55, 0x4e, 0x49,
+    0x46, 0x4f, 0x52, 0x4d, 0x5f, 0x42, 0x55, 0x46, 0x46, 0x45, 0x52, 0x0a, 0x6c, 0x61, 0x79, 0x6f,
+    0x75, 0x74, 0x28, 0x73, 0x74, 0x64, 0x31, 0x34, 0x30, 0x29, 0x20, 0x75, 0x6e, 0x69, 0x66, 0x6f,
+    0x72, 0x6d, 0x20, 0x43, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x0a, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20,
+    0x6d, 0x61, 0x74, 0x34, 0x20, 0x76, 0x69, 0x65, 0x77, 0x4d, 0x61, 0x74, 0x72, 0x69, 0x78, 0x3b,
+    0x0a, 0x20, 0x20, 0x20, 0x20, 0x6d, 0x61, 0x74, 0x34, 0x20, 0x70, 0x72, 0x6f, 0x6a, 0x65, 0x63,
+    0x74, 0x69, 0x6f, 0x6e, 0x4d, 0x61, 0x74, 0x72, 0x69, 0x78, 0x3b, 0x0a, 0x7d, 0x3b, 0x0a, 0x23,
+    0x65, 0x6c, 0x73, 0x65, 0x0a, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x6d, 0x61, 0x74,
+    0x34, 0x20, 0x76, 0x69, 0x65, 0x77, 0x4d, 0x61, 0x74, 0x72, 0x69, 0x78, 0x3b, 0x0a, 0x75, 0x6e,
+    0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x6d, 0x61, 0x74, 0x34, 0x20, 0x70, 0x72, 0x6f, 0x6a, 0x65,
+    0x63, 0x74, 0x69, 0x6f, 0x6e, 0x4d, 0x61, 0x74, 0x72, 0x69, 0x78, 0x3b, 0x0a, 0x23, 0x65, 0x6e,
+    0x64, 0x69, 0x66, 0x0a, 0x0a, 0x76, 0x61, 0x72, 0x79, 0x69, 0x6e, 0x67, 0x20, 0x76, 0x65, 0x63,
+    0x32, 0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x56, 0x61, 0x72, 0x3b, 0x0a, 0x76,
+    0x61, 0x72, 0x79, 0x69, 0x6e, 0x67, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x74, 0x69, 0x6e, 0x74,
+    0x56, 0x61, 0x72, 0x3b, 0x0a, 0x0a, 0x76, 0x6f, 0x69, 0x64, 0x20, 0x6d, 0x61, 0x69, 0x6e, 0x28,
+    0x29, 0x0a, 0x7b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x34, 0x20, 0x70, 0x20, 0x3d, 0x20, 0x76, 0x69,
+    0x65, 0x77, 0x4d, 0x61, 0x74, 0x72, 0x69, 0x78, 0x20, 0x2a, 0x20, 0x76, 0x65, 0x63, 0x34, 0x28,
+    0x6d, 0x61, 0x74, 0x32, 0x28, 0x69, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x4c, 0x69, 0x6e,
+    0x65, 0x61, 0x72, 0x2e, 0x78, 0x79, 0x2c, 0x20, 0x69, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x63, 0x65,
+    0x4c, 0x69, 0x6e, 0x65, 0x61, 0x72, 0x2e, 0x7a, 0x77, 0x29, 0x20, 0x2a, 0x20, 0x70, 0x6f, 0x73,
+    0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2e, 0x78, 0x79, 0x20, 0x2b, 0x20, 0x69, 0x6e, 0x73, 0x74, 0x61,
+    0x6e, 0x63, 0x65, 0x54, 0x72, 0x61, 0x6e, 0x73, 0x6c, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x2e, 0x78,
+    0x79, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+    0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+    0x20, 0x20, 0x69, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x54, 0x72, 0x61, 0x6e, 0x73, 0x6c,
+    0x61, 0x74, 0x69, 0x6f, 0x6e, 0x2e, 0x7a, 0x2c, 0x20, 0x31, 0x2e, 0x30, 0x29, 0x3b, 0x0a, 0x20,
+    0x20, 0x20, 0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x56, 0x61, 0x72, 0x20, 0x3d,
+    0x20, 0x69, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x55, 0x76, 0x52, 0x65, 0x63, 0x74, 0x2e,
+    0x78, 0x79, 0x20, 0x2b, 0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x20, 0x2a, 0x20,
+    0x69, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x55, 0x76, 0x52, 0x65, 0x63, 0x74, 0x2e, 0x7a,
+    0x77, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x74, 0x69, 0x6e, 0x74, 0x56, 0x61, 0x72, 0x20, 0x3d,
+    0x20, 0x69, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x54, 0x69, 0x6e, 0x74, 0x3b, 0x0a, 0x09,
+    0x67, 0x6c, 0x5f, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x70, 0x72,
+    0x6f, 0x6a, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x4d, 0x61, 0x74, 0x72, 0x69, 0x78, 0x20, 0x2a,
+    0x20, 0x70, 0x3b, 0x0a, 0x7d, 0x0a, 0x00,
+};
+
+// shaders/vertex_textured.glsl
+constexpr char SHADERS_VERTEX_TEXTURED_GLSL[] = {
+    0x61, 0x74, 0x74, 0x72, 0x69, 0x62, 0x75, 0x74, 0x65, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x70,
+    0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x61, 0x74, 0x74, 0x72, 0x69, 0x62, 0x75,
+    0x74, 0x65, 0x20, 0x76, 0x65, 0x63, 0x32, 0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64,
+    0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x54, 0x68, 0x65, 0x20, 0x6d, 0x6f, 0x64, 0x65, 0x6c, 0x20,
+    0x74, 0x72, 0x61, 0x6e, 0x73, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x61, 0x73, 0x20, 0x61, 0x20, 0x32,
+    0x78, 0x32, 0x20, 0x6c, 0x69, 0x6e, 0x65, 0x61, 0x72, 0x20, 0x70, 0x61, 0x72, 0x74, 0x20, 0x28,
+    0x63, 0x6f, 0x6c, 0x75, 0x6d, 0x6e, 0x73, 0x20, 0x69, 0x6e, 0x20, 0x78, 0x79, 0x20, 0x61, 0x6e,
+    0x64, 0x20, 0x7a, 0x77, 0x29, 0x20, 0x70, 0x6c, 0x75, 0x73, 0x20, 0x61, 0x20, 0x74, 0x72, 0x61,
+    0x6e, 0x73, 0x6c, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x77, 0x68, 0x6f, 0x73, 0x65, 0x20, 0x7a,
+    0x20, 0x69, 0x73, 0x20, 0x64, 0x65, 0x70, 0x74, 0x68, 0x0a, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72,
+    0x6d, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x6d, 0x6f, 0x64, 0x65, 0x6c, 0x4c, 0x69, 0x6e, 0x65,
+    0x61, 0x72, 0x3b, 0x0a, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x76, 0x65, 0x63, 0x33,
+    0x20, 0x6d, 0x6f, 0x64, 0x65, 0x6c, 0x54, 0x72, 0x61, 0x6e, 0x73, 0x6c, 0x61, 0x74, 0x69, 0x6f,
+    0x6e, 0x3b, 0x0a, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20,
+    0x75, 0x76, 0x52, 0x65, 0x63, 0x74, 0x3b, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x53, 0x68, 0x61, 0x72,
+    0x65, 0x64, 0x20, 0x62, 0x79, 0x20, 0x65, 0x76, 0x65, 0x72, 0x79, 0x20, 0x70, 0x72, 0x6f, 0x67,
+    0x72, 0x61, 0x6d, 0x3a, 0x20, 0x61, 0x20, 0x73, 0x69, 0x6e, 0x67, 0x6c, 0x65, 0x20, 0x75, 0x6e,
+    0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x62, 0x75, 0x66, 0x66, 0x65, 0x72, 0x20, 0x77, 0x68, 0x65,
+    0x6e, 0x20, 0x74, 0x68, 0x65, 0x20, 0x63, 0x6f, 0x6e, 0x74, 0x65, 0x78, 0x74, 0x20, 0x68, 0x61,
+    0x73, 0x20, 0x74, 0x68, 0x65, 0x6d, 0x2c, 0x20, 0x70, 0x6c, 0x61, 0x69, 0x6e, 0x20, 0x75, 0x6e,
+    0x69, 0x66, 0x6f, 0x72, 0x6d, 0x73, 0x20, 0x6f, 0x74, 0x68, 0x65, 0x72, 0x77, 0x69, 0x73, 0x65,
+    0x0a, 0x23, 0x69, 0x66, 0x64, 0x65, 0x66, 0x20, 0x43, 0x41, 0x4d, 0x45, 0x52, 0x41, 0x5f, 0x55,
+    0x4e, 0x49, 0x46, 0x4f, 0x52, 0x4d, 0x5f, 0x42, 0x55, 0x46, 0x46, 0x45, 0x52, 0x0a, 0x6c, 0x61,
+    0x79, 0x6f, 0x75, 0x74, 0x28, 0x73, 0x74, 0x64, 0x31, 0x34, 0x30, 0x29, 0x20, 0x75, 0x6e, 0x69,
+    0x66, 0x6f, 0x72, 0x6d, 0x20, 0x43, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x0a, 0x7b, 0x0a, 0x20, 0x20,
+    0x20, 0x20, 0x6d, 0x61, 0x74, 0x34, 0x20, 0x76, 0x69, 0x65, 0x77, 0x4d, 0x61, 0x74, 0x72, 0x69,
+    0x78, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x6d, 0x61, 0x74, 0x34, 0x20, 0x70, 0x72, 0x6f, 0x6a,
+    0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x4d, 0x61, 0x74, 0x72, 0x69, 0x78, 0x3b, 0x0a, 0x7d, 0x3b,
+    0x0a, 0x23, 0x65, 0x6c, 0x73, 0x65, 0x0a, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x6d,
+    0x61, 0x74, 0x34, 0x20, 0x76, 0x69, 0x65, 0x77, 0x4d, 0x61, 0x74, 0x72, 0x69, 0x78, 0x3b, 0x0a,
+    0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x6d, 0x61, 0x74, 0x34, 0x20, 0x70, 0x72, 0x6f,
+    0x6a, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x4d, 0x61, 0x74, 0x72, 0x69, 0x78, 0x3b, 0x0a, 0x23,
+    0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x0a, 0x76, 0x61, 0x72, 0x79, 0x69, 0x6e, 0x67, 0x20, 0x76,
+    0x65, 0x63, 0x32, 0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x56, 0x61, 0x72, 0x3b,
+    0x0a, 0x0a, 0x76, 0x6f, 0x69, 0x64, 0x20, 0x6d, 0x61, 0x69, 0x6e, 0x28, 0x29, 0x0a, 0x7b, 0x0a,
+    0x09, 0x76, 0x65, 0x63, 0x34, 0x20, 0x70, 0x20, 0x3d, 0x20, 0x76, 0x69, 0x65, 0x77, 0x4d, 0x61,
+    0x74, 0x72, 0x69, 0x78, 0x20, 0x2a, 0x20, 0x76, 0x65, 0x63, 0x34, 0x28, 0x6d, 0x61, 0x74, 0x32,
+    0x28, 0x6d, 0x6f, 0x64, 0x65, 0x6c, 0x4c, 0x69, 0x6e, 0x65, 0x61, 0x72, 0x2e, 0x78, 0x79, 0x2c,
+    0x20, 0x6d, 0x6f, 0x64, 0x65, 0x6c, 0x4c, 0x69, 0x6e, 0x65, 0x61, 0x72, 0x2e, 0x7a, 0x77, 0x29,
+    0x20, 0x2a, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2e, 0x78, 0x79, 0x20, 0x2b,
+    0x20, 0x6d, 0x6f, 0x64, 0x65, 0x6c, 0x54, 0x72, 0x61, 0x6e, 0x73, 0x6c, 0x61, 0x74, 0x69, 0x6f,
+    0x6e, 0x2e, 0x78, 0x79, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+    0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+    0x20, 0x20, 0x20, 0x20, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2e, 0x7a, 0x20,
+    0x2b, 0x20, 0x6d, 0x6f, 0x64, 0x65, 0x6c, 0x54, 0x72, 0x61, 0x6e, 0x73, 0x6c, 0x61, 0x74, 0x69,
+    0x6f, 0x6e, 0x2e, 0x7a, 0x2c, 0x20, 0x31, 0x2e, 0x30, 0x29, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20,
+    0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x56, 0x61, 0x72, 0x20, 0x3d, 0x20, 0x75, 0x76,
+    0x52, 0x65, 0x63, 0x74, 0x2e, 0x78, 0x79, 0x20, 0x2b, 0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f,
+    0x72, 0x64, 0x20, 0x2a, 0x20, 0x75, 0x76, 0x52, 0x65, 0x63, 0x74, 0x2e, 0x7a, 0x77, 0x3b, 0x0a,
+    0x09, 0x67, 0x6c, 0x5f, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x70,
+    0x72, 0x6f, 0x6a, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x4d, 0x61, 0x74, 0x72, 0x69, 0x78, 0x20,
+    0x2a, 0x20, 0x70, 0x3b, 0x0a, 0x7d, 0x00,
+};
+
+constexpr EmbeddedFile EMBEDDED_FILES[] = {
+    { "shaders/fragment.glsl", SHADERS_FRAGMENT_GLSL, sizeof(SHADERS_FRAGMENT_GLSL) - 1 },
+    { "shaders/fragment_instanced.glsl", SHADERS_FRAGMENT_INSTANCED_GLSL, sizeof(SHADERS_FRAGMENT_INSTANCED_GLSL) - 1 },
+    { "shaders/fragment_textured.glsl", SHADERS_FRAGMENT_TEXTURED_GLSL, sizeof(SHADERS_FRAGMENT_TEXTURED_GLSL) - 1 },
+    { "shaders/vertex.glsl", SHADERS_VERTEX_GLSL, sizeof(SHADERS_VERTEX_GLSL) - 1 },
+    { "shaders/vertex_instanced.glsl", SHADERS_VERTEX_INSTANCED_GLSL, sizeof(SHADERS_VERTEX_INSTANCED_GLSL) - 1 },
+    { "shaders/vertex_textured.glsl", SHADERS_VERTEX_TEXTURED_GLSL, sizeof(SHADERS_VERTEX_TEXTURED_GLSL) - 1 },
+};
+
+inline const EmbeddedFile* find_embedded_file(const char *path)
+{
+    for (const EmbeddedFile &file : EMBEDDED_FILES)
+        if (std::strcmp(file.path, path) == 0) return &file;
+    return nullptr;
+}
@@ -22,10 +22,15 @@
 #include "glm/gtc/matrix_transform.hpp"
 #include "ShaderProgram.h"
 #include "Entity.h"
+#include "SpriteBatch.h"
+#include "SpriteRenderer.h"
+
+std::atomic<int> Entity::s_transforms_rebuilt { 0 },
+                 Entity::s_transforms_cached  { 0 };
 
 // Default constructor
 Entity::Entity()
-    : m_position(0.0f), m_movement(0.0f), m_scale(1.0f, 1.0f, 0.0f), m_model_matrix(1.0f),
+    : m_position(0.0f), m_movement(0.0f), m_scale(1.0f, 1.0f, 0.0f),
       m_speed(0.0f), m_animation_cols(0), m_animation_frames(0), m_animation_index(0),
       m_animation_rows(0), m_animation_indices(nullptr), m_animation_time(0.0f),
 m_texture_id(0), m_velocity(0.0f), m_acceleration(0.0f)
@@ -39,7 +44,7 @@ m_texture_id(0), m_velocity(0.0f), m_acceleration(0.0f)
 Entity::Entity(GLuint texture_id, float speed, int walking[4][4], float animation_time,
                int animation_frames, int animation_index, int animation_cols,
                int animation_rows)
-    : m_position(0.0f), m_movement(0.0f), m_scale(1.0f, 1.0f, 0.0f), m_model_matrix(1.0f),
+    : m_position(0.0f), m_movement(0.0f), m_scale(1.0f, 1.0f, 0.0f),
       m_speed(speed), m_animation_cols(animation_cols),
       m_animation_frames(animation_frames), m_animation_index(animation_index),
       m_animation_rows(animation_rows), m_animation_indices(nullptr),
@@ -50,7 +55,7 @@ Entity::Entity(GLuint texture_id, float speed, int walking[4][4], float animatio
 
 // Simpler constructor for partial initialization
 Entity::Entity(GLuint texture_id, float speed)
-    : m_position(0.0f), m_movement(0.0f), m_scale(1.0f, 1.0f, 0.0f), m_model_matrix(1.0f),
+    : m_position(0.0f), m_movement(0.0f), m_scale(1.0f, 1.0f, 0.0f),
       m_speed(speed), m_animation_cols(0), m_animation_frames(0), m_animation_index(0),
       m_animation_rows(0), m_animation_indices(nullptr), m_animation_time(0.0f),
       m_texture_id(texture_id), m_velocity(0.0f), m_acceleration(0.0f)
@@ -62,42 +67,29 @@ Entity::Entity(GLuint texture_id, float speed)
 
 Entity::~Entity() { }
 
-void Entity::draw_sprite_from_texture_atlas(ShaderProgram *program, GLuint texture_id, int index)
+void Entity::draw_sprite_from_texture_atlas(SpriteRenderer *renderer, GLuint texture_id, int index)
 {
-    // Step 1: Calculate the UV location of the indexed frame
-    float u_coord = (float) (index % m_animation_cols) / (float) m_animation_cols;
-    float v_coord = (float) (index / m_animation_cols) / (float) m_animation_rows;
-    
-    // Step 2: Calculate its UV size
-    float width = 1.0f / (float) m_animation_cols;
-    float height = 1.0f / (float) m_animation_rows;
-    
-    // Step 3: Just as we have done before, match the texture coordinates to the vertices
-    float tex_coords[] =
-    {
-        u_coord, v_coord + height, u_coord + width, v_coord + height, u_coord + width, v_coord,
-        u_coord, v_coord + height, u_coord + width, v_coord, u_coord, v_coord
-    };
-    
-    float vertices[] =
-    {
-        -0.5, -0.5, 0.5, -0.5,  0.5, 0.5,
-        -0.5, -0.5, 0.5,  0.5, -0.5, 0.5
-    };
-    
-    // Step 4: And render
-    glBindTexture(GL_TEXTURE_2D, texture_id);
-    
-    glVertexAttribPointer(program->get_position_attribute(), 2, GL_FLOAT, false, 0, vertices);
-    glEnableVertexAttribArray(program->get_position_attribute());
-    
-    glVertexAttribPointer(program->get_tex_coordinate_attribute(), 2, GL_FLOAT, false, 0, tex_coords);
-    glEnableVertexAttribArray(program->get_tex_coordinate_attribute());
+    // The unit quad already sits in GPU buffers; only the UV window of the indexed frame changes
+    renderer->draw(texture_id, get_transform(), get_frame_uv_rect(index));
+}
+
+glm::vec4 const Entity::get_frame_uv_rect(int index) const
+{
+    if (m_animation_cols == 0 || m_animation_rows == 0) return m_uv_rect;
     
-    glDrawArrays(GL_TRIANGLES, 0, 6);
+    // Frames are laid out within the sprite's own region, which is the whole texture unless it was atlased
+    float width  = m_uv_rect.z / (float) m_animation_cols;
+    float height = m_uv_rect.w / (float) m_animation_rows;
     
-    glDisableVertexAttribArray(program->get_position_attribute());
-    glDisableVertexAttribArray(program->get_tex_coordinate_attribute());
+    return glm::vec4(m_uv_rect.x + (float) (index % m_animation_cols) * width,
+                     m_uv_rect.y + (float) (index / m_animation_cols) * height,
+                     width, height);
+}
+
+glm::vec4 const Entity::get_current_uv_rect() const
+{
+    if (m_animation_indices != NULL) return get_frame_uv_rect(m_animation_indices[m_animation_index]);
+    return m_uv_rect;
 }
 
 bool const Entity::check_collision(Entity* other) const
@@ -156,12 +148,11 @@ void Entity::update(float delta_time, Entity* collidable_entities_first, Entity*
     m_velocity.x = m_movement.x * m_speed;
     m_velocity += m_acceleration * delta_time;
     
-    m_position += m_velocity * delta_time;
-
-    m_model_matrix = glm::mat4(1.0f);
-    m_model_matrix = glm::translate(m_model_matrix, m_position);
-    m_model_matrix = glm::rotate(m_model_matrix, m_rotate_angle, m_roatet_vec);
-    m_model_matrix = glm::scale(m_model_matrix, m_scale);
+    if (m_velocity != glm::vec3(0.0f))
+    {
+        m_position += m_velocity * delta_time;
+        invalidate_transform();
+    }
 }
 
 void Entity::update(float delta_time)
@@ -188,36 +179,51 @@ void Entity::update(float delta_time)
     
     m_velocity.x = m_movement.x * m_speed;
     m_velocity += m_acceleration * delta_time;
-    m_position += m_velocity * delta_time;
-    m_model_matrix = glm::mat4(1.0f);
-    m_model_matrix = glm::translate(m_model_matrix, m_position);
-    m_model_matrix = glm::rotate(m_model_matrix, m_rotate_angle, m_roatet_vec);
-    m_model_matrix = glm::scale(m_model_matrix, m_scale);
+    if (m_velocity != glm::vec3(0.0f))
+    {
+        m_position += m_velocity * delta_time;
+        invalidate_transform();
+    }
 }
 
-void Entity::render(ShaderProgram *program)
+Transform2D const &Entity::get_transform() const
 {
-    program->set_model_matrix(m_model_matrix);
+    if (!m_transform_dirty)
+    {
+        s_transforms_cached++;
+        return m_transform;
+    }
     
+    m_transform = Transform2D::compose(m_position, m_rotate_cos, m_rotate_sin, m_roatet_vec, m_scale);
+    m_transform_dirty = false;
+    s_transforms_rebuilt++;
+    return m_transform;
+}
+
+SpriteSnapshot const Entity::get_snapshot() const
+{
+    SpriteSnapshot snapshot;
+    snapshot.transform  = get_transform();
+    snapshot.uv_rect    = get_current_uv_rect();
+    snapshot.texture_id = m_texture_id;
+    snapshot.depth      = m_position.z;
+    snapshot.opaque     = m_opaque;
+    return snapshot;
+}
+
+void Entity::render(SpriteRenderer *renderer)
+{
     if (m_animation_indices != NULL)
     {
-        draw_sprite_from_texture_atlas(program, m_texture_id,
+        draw_sprite_from_texture_atlas(renderer, m_texture_id,
                                        m_animation_indices[m_animation_index]);
         return;
     }
     
-    float vertices[]   = { -0.5, -0.5, 0.5, -0.5, 0.5, 0.5, -0.5, -0.5, 0.5, 0.5, -0.5, 0.5 };
-    float tex_coords[] = {  0.0,  1.0, 1.0,  1.0, 1.0, 0.0,  0.0,  1.0, 1.0, 0.0,  0.0, 0.0 };
-    
-    glBindTexture(GL_TEXTURE_2D, m_texture_id);
-    
-    glVertexAttribPointer(program->get_position_attribute(), 2, GL_FLOAT, false, 0, vertices);
-    glEnableVertexAttribArray(program->get_position_attribute());
-    glVertexAttribPointer(program->get_tex_coordinate_attribute(), 2, GL_FLOAT, false, 0, tex_coords);
-    glEnableVertexAttribArray(program->get_tex_coordinate_attribute());
-    
-    glDrawArrays(GL_TRIANGLES, 0, 6);
-    
-    glDisableVertexAttribArray(program->get_position_attribute());
-    glDisableVertexAttribArray(program->get_tex_coordinate_attribute());
+    renderer->draw(m_texture_id, get_transform(), m_uv_rect);
+}
+
+void Entity::submit(SpriteBatch *batch) const
+{
+    batch->draw(m_texture_id, get_transform(), get_current_uv_rect());
 }
@@ -1,5 +1,12 @@
+#include <atomic>
+#include "Transform2D.h"
+#include "SpriteSnapshot.h"
+
 enum AnimationDirection { LEFT, RIGHT, UP, DOWN };
 
+class SpriteBatch;
+class SpriteRenderer;
+
 class Entity
 {
 private:
@@ -14,9 +21,20 @@ private:
     glm::vec3 m_scale;
     glm::vec3 m_roatet_vec = glm::vec3(0.0f, 1.0f, 0.0f);
     
-    float m_rotate_angle;
+    float m_rotate_angle = 0.0f;
+    // Kept alongside the angle so transforms never call sin/cos themselves
+    float m_rotate_cos   = 1.0f;
+    float m_rotate_sin   = 0.0f;
+    
+    // Rebuilt lazily: setters and movement only mark it stale
+    mutable Transform2D m_transform;
+    mutable bool        m_transform_dirty = true;
+    // Where the entity was at the start of the current fixed step, for render interpolation
+    Transform2D         m_previous_transform;
+    bool                m_has_previous_transform = false;
     
-    glm::mat4 m_model_matrix;
+    // Bumped whenever the transform or texture changes, so cached renderings can tell they are stale
+    unsigned int m_revision = 0;
     
     float     m_speed;
     float     m_width;
@@ -30,6 +48,8 @@ private:
     
     // ————— TEXTURES ————— //
     GLuint    m_texture_id;
+    glm::vec4 m_uv_rect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f); // sub-rectangle when the texture is an atlas page
+    bool      m_opaque  = false;                               // every texel of the sprite has full alpha
 
     // ————— ANIMATION ————— //
     int m_animation_cols;
@@ -40,6 +60,21 @@ private:
     int  *m_animation_indices = nullptr;
     float m_animation_time    = 0.0f;
     
+    glm::vec4 const get_frame_uv_rect(int index) const;
+    void const invalidate_transform() { m_transform_dirty = true; m_revision++; }
+    
+public:
+    struct TransformCounters
+    {
+        int rebuilt = 0;
+        int cached  = 0;
+    };
+    
+private:
+    // Atomic because the simulation and render threads both resolve transforms
+    static std::atomic<int> s_transforms_rebuilt,
+                            s_transforms_cached;
+    
 public:
     // ————— STATIC VARIABLES ————— //
     static constexpr int SECONDS_PER_FRAME = 4;
@@ -52,13 +87,14 @@ public:
     Entity(GLuint texture_id, float speed); // Simpler constructor
     ~Entity();
 
-    void draw_sprite_from_texture_atlas(ShaderProgram *program, GLuint texture_id,
+    void draw_sprite_from_texture_atlas(SpriteRenderer *renderer, GLuint texture_id,
                                         int index);
     
     bool const check_collision(Entity *other) const;
     
     void update(float delta_time);
-    void render(ShaderProgram *program);
+    void render(SpriteRenderer *renderer);
+    void submit(SpriteBatch *batch) const;
     void update(float delta_time, Entity* collidable_entities, Entity** collidable_entities_second, int entity_count, int entity_count_second, bool& gameStatus, bool& ifLose, bool& ifWin);
     
     void normalise_movement() { m_movement = glm::normalize(m_movement); };
@@ -77,23 +113,38 @@ public:
     glm::vec3 const get_acceleration() const { return m_acceleration; };
     glm::vec3 const get_movement()     const { return m_movement; };
     glm::vec3 const get_scale()      const { return m_scale;      }
+    glm::mat4 const get_model_matrix() const { return get_transform().to_mat4(); }
+    Transform2D const &get_transform() const;
+    SpriteSnapshot const get_snapshot() const;
+    Transform2D const &get_previous_transform() const { return m_has_previous_transform ? m_previous_transform : get_transform(); }
+    // Call before each fixed step moves the entity
+    void store_previous_transform() { m_previous_transform = get_transform(); m_has_previous_transform = true; }
     float const get_rotate_angle() const {return m_rotate_angle;     }
+    unsigned int const get_revision() const { return m_revision; }
+    float     const get_depth()      const { return m_position.z; }
+    bool      const is_opaque()      const { return m_opaque;     }
     GLuint    const get_texture_id() const { return m_texture_id; }
+    glm::vec4 const get_uv_rect()    const { return m_uv_rect;    }
+    glm::vec4 const get_current_uv_rect() const;
     float     const get_speed()      const { return m_speed;      }
     float       const get_width()      const { return m_width; }
     float       const get_height()      const { return m_height; }
 
     // ————— SETTERS ————— //
-    void const set_position(glm::vec3 new_position) { m_position = new_position; };
+    void const set_position(glm::vec3 new_position) { m_position = new_position; invalidate_transform(); };
     void const set_velocity(glm::vec3 new_velocity) { m_velocity = new_velocity; };
     void const set_acceleration(glm::vec3 new_position) { m_acceleration = new_position; };
     void const set_acceleration_x(float new_x) { m_acceleration.x = new_x; };
     void const set_acceleration_y(float new_y) { m_acceleration.y = new_y; };
     void const set_movement(glm::vec3 new_movement) { m_movement = new_movement; };
-    void const set_rotate_angle(float new_angle) { m_rotate_angle = new_angle; };
-    void const set_scale(glm::vec3 new_scale)        { m_scale      = new_scale;        }
-    void const set_texture_id(GLuint new_texture_id) { m_texture_id = new_texture_id;   }
-    void const set_rotate_vec(glm::vec3 new_vec) { m_roatet_vec = new_vec; }
+    void const set_rotate_angle(float new_angle) { m_rotate_angle = new_angle; m_rotate_cos = cosf(new_angle); m_rotate_sin = sinf(new_angle); invalidate_transform(); };
+    void const set_scale(glm::vec3 new_scale)        { m_scale      = new_scale;      invalidate_transform(); }
+    void const set_texture_id(GLuint new_texture_id) { m_texture_id = new_texture_id; m_uv_rect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f); m_revision++; }
+    void const set_texture_region(GLuint new_texture_id, glm::vec4 new_uv_rect) { m_texture_id = new_texture_id; m_uv_rect = new_uv_rect; m_revision++; }
+    void const set_rotate_vec(glm::vec3 new_vec) { m_roatet_vec = glm::normalize(new_vec); invalidate_transform(); }
+    // Larger is nearer the viewer; the projection keeps [-1, 1]
+    void const set_depth(float new_depth) { m_position.z = new_depth; invalidate_transform(); }
+    void const set_opaque(bool new_opaque) { m_opaque = new_opaque; }
     
     void const set_width(float new_width) { m_width = new_width; }
     void const set_height(float new_height) { m_height = new_height; }
@@ -115,4 +166,8 @@ public:
             }
         }
     }
+
+    // ————— TRANSFORM COUNTERS ————— //
+    static TransformCounters const get_transform_counters() { return { s_transforms_rebuilt, s_transforms_cached }; }
+    static void reset_transform_counters()                  { s_transforms_rebuilt = 0; s_transforms_cached = 0; }
 };
@@ -0,0 +1,121 @@
+#include "Image.h"
+#include "stb_image.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+
+bool load_image(const char *filepath, Image &image)
+{
+    int width, height, number_of_components;
+    unsigned char* pixels = stbi_load(filepath, &width, &height, &number_of_components, STBI_rgb_alpha);
+    
+    if (pixels == NULL)
+    {
+        std::cout << "Unable to load image " << filepath << ". Make sure the path is correct." << std::endl;
+        return false;
+    }
+    
+    image.width  = width;
+    image.height = height;
+    image.pixels.resize((std::size_t) width * height * Image::BYTES_PER_PIXEL);
+    std::memcpy(image.pixels.data(), pixels, image.pixels.size());
+    
+    stbi_image_free(pixels);
+    return true;
+}
+
+Image resize_image(const Image &source, int width, int height)
+{
+    Image result;
+    result.width  = width;
+    result.height = height;
+    result.pixels.resize((std::size_t) width * height * Image::BYTES_PER_PIXEL);
+    
+    for (int y = 0; y < height; y++)
+    {
+        int source_y0 = (int) ((long long) y * source.height / height),
+            source_y1 = std::max(source_y0 + 1, (int) ((long long) (y + 1) * source.height / height));
+        
+        for (int x = 0; x < width; x++)
+        {
+            int source_x0 = (int) ((long long) x * source.width / width),
+                source_x1 = std::max(source_x0 + 1, (int) ((long long) (x + 1) * source.width / width));
+            
+            std::uint64_t red = 0, green = 0, blue = 0, alpha = 0, count = 0;
+            for (int sy = source_y0; sy < source_y1; sy++)
+            {
+                const unsigned char *texel = source.pixel(source_x0, sy);
+                for (int sx = source_x0; sx < source_x1; sx++, texel += Image::BYTES_PER_PIXEL)
+                {
+                    red   += texel[0] * texel[3];
+                    green += texel[1] * texel[3];
+                    blue  += texel[2] * texel[3];
+                    alpha += texel[3];
+                    count++;
+                }
+            }
+            
+            unsigned char *out = result.pixel(x, y);
+            if (alpha == 0)
+            {
+                out[0] = out[1] = out[2] = out[3] = 0;
+                continue;
+            }
+            out[0] = (unsigned char) (red   / alpha);
+            out[1] = (unsigned char) (green / alpha);
+            out[2] = (unsigned char) (blue  / alpha);
+            out[3] = (unsigned char) ((alpha + count / 2) / count);
+        }
+    }
+    
+    return result;
+}
+
+bool is_opaque(const ImageView &image)
+{
+    std::size_t texel_count = (std::size_t) image.width * image.height;
+    for (std::size_t i = 0; i < texel_count; i++)
+        if (image.pixels[i * Image::BYTES_PER_PIXEL + 3] != 255) return false;
+    
+    return true;
+}
+
+void downscale_to_fit(Image &image, int max_width, int max_height)
+{
+    int width  = max_width  > 0 ? std::min(image.width,  max_width)  : image.width,
+        height = max_height > 0 ? std::min(image.height, max_height) : image.height;
+    
+    if (width == image.width && height == image.height) return;
+    
+    image = resize_image(image, std::max(width, 1), std::max(height, 1));
+}
+
+void build_mip_chain(const Image &base, std::vector<Image> &levels, int max_levels)
+{
+    levels.clear();
+    levels.reserve(max_levels);
+    
+    const Image *previous = &base;
+    while ((int) levels.size() + 1 < max_levels && (previous->width > 1 || previous->height > 1))
+    {
+        levels.push_back(resize_image(*previous, std::max(previous->width / 2, 1), std::max(previous->height / 2, 1)));
+        previous = &levels.back();
+    }
+}
+
+int mip_level_to_fit(int width, int height, int level_count, int max_width, int max_height)
+{
+    int target_width  = max_width  > 0 ? std::min(width,  max_width)  : width,
+        target_height = max_height > 0 ? std::min(height, max_height) : height;
+    
+    int level = 0;
+    while (level + 1 < level_count && width / 2 >= target_width && height / 2 >= target_height)
+    {
+        width  /= 2;
+        height /= 2;
+        level++;
+    }
+    
+    return level;
+}
@@ -0,0 +1,63 @@
+#include "KtxTexture.h"
+#include "Image.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+bool KtxTexture::load(const char *filepath)
+{
+    m_file.clear();
+
+    std::ifstream file(filepath, std::ios::binary);
+    if (!file) return false;
+
+    m_file.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    if (m_file.size() < sizeof(Ktx2Header)) { m_file.clear(); return false; }
+
+    const Ktx2Header *header = get_header();
+    bool valid = std::memcmp(header->identifier, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) == 0 &&
+                 (header->vk_format == KTX_BC1_RGB_UNORM || header->vk_format == KTX_BC1_RGBA_UNORM ||
+                  header->vk_format == KTX_BC3_UNORM) &&
+                 header->pixel_depth == 0 && header->layer_count <= 1 && header->face_count == 1 &&
+                 header->level_count > 0 && header->supercompression_scheme == 0 &&
+                 sizeof(Ktx2Header) + header->level_count * sizeof(Ktx2LevelIndex) <= m_file.size();
+
+    for (int level = 0; valid && level < (int) header->level_count; level++)
+    {
+        const Ktx2LevelIndex &index = get_index()[level];
+        Level expected = get_level(level);
+        valid = index.byte_offset + index.byte_length <= m_file.size() && index.byte_length == expected.byte_size;
+    }
+
+    if (!valid) m_file.clear();
+    return valid;
+}
+
+std::string KtxTexture::path_for(const char *source_path)
+{
+    std::string path = source_path;
+    std::size_t dot  = path.find_last_of('.');
+    std::size_t name = path.find_last_of("/\\");
+
+    if (dot != std::string::npos && (name == std::string::npos || dot > name)) path.erase(dot);
+    return path + ".ktx2";
+}
+
+KtxTexture::Level const KtxTexture::get_level(int level) const
+{
+    Level result;
+    result.width  = std::max(get_width()  >> level, 1);
+    result.height = std::max(get_height() >> level, 1);
+
+    // Partial blocks at the edges still take a whole block
+    result.byte_size = (std::size_t) ((result.width + 3) / 4) * ((result.height + 3) / 4) * block_size(get_vk_format());
+    result.data      = m_file.data() + get_index()[level].byte_offset;
+
+    return result;
+}
+
+int const KtxTexture::get_level_to_fit(int max_width, int max_height) const
+{
+    return mip_level_to_fit(get_width(), get_height(), get_level_count(), max_width, max_height);
+}
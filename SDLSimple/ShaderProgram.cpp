@@ -1,20 +1,87 @@
 #define GL_SILENCE_DEPRECATION
 
 #include "ShaderProgram.h"
+#include "ShaderCache.h"
+#include "GLExtensions.h"
+
+GLuint                       ShaderProgram::s_bound_program = 0;
+ShaderProgram::StateCounters ShaderProgram::s_counters;
+const Camera                *ShaderProgram::s_camera = nullptr;
+
+// Prepended to every stage when the camera lives in a uniform buffer; the shaders test CAMERA_UNIFORM_BUFFER
+constexpr char UNIFORM_BUFFER_PREAMBLE[] = "#version 120\n"
+                                           "#extension GL_ARB_uniform_buffer_object : require\n"
+                                           "#define CAMERA_UNIFORM_BUFFER 1\n";
+
+static std::string_view shader_preamble()
+{
+    return g_gl_extensions.uniform_buffer_object ? UNIFORM_BUFFER_PREAMBLE : "";
+}
 
 void ShaderProgram::load(const char *vertex_shader_file, const char *fragment_shader_file) {
     
+    load_from_memory(read_shader_file(vertex_shader_file), read_shader_file(fragment_shader_file));
+}
+
+void ShaderProgram::load_from_memory(std::string_view vertex_source, std::string_view fragment_source)
+{
+    submit(vertex_source, fragment_source);
+    wait();
+}
+
+void ShaderProgram::submit(std::string_view vertex_source, std::string_view fragment_source)
+{
+    m_program_id      = glCreateProgram();
+    m_vertex_shader   = 0;
+    m_fragment_shader = 0;
+    m_pending         = false;
+    
+    // A cached binary for this driver and these exact sources skips compiling entirely
+    m_source_hash = ShaderCache::hash(shader_preamble(), ShaderCache::source_hash(vertex_source, fragment_source));
+    if (g_shader_cache.load(m_program_id, m_source_hash))
+    {
+        locate_variables();
+        return;
+    }
+    
     // create the vertex shader
-    m_vertex_shader = load_shader_from_file(vertex_shader_file, GL_VERTEX_SHADER);
+    m_vertex_shader = load_shader_from_string(vertex_source, GL_VERTEX_SHADER);
     // create the fragment shader
-    m_fragment_shader = load_shader_from_file(fragment_shader_file, GL_FRAGMENT_SHADER);
+    m_fragment_shader = load_shader_from_string(fragment_source, GL_FRAGMENT_SHADER);
     
     // Create the final shader program from our vertex and fragment shaders
-    m_program_id = glCreateProgram();
     glAttachShader(m_program_id, m_vertex_shader);
     glAttachShader(m_program_id, m_fragment_shader);
+    g_shader_cache.prepare(m_program_id);
     glLinkProgram(m_program_id);
     
+    // No status queries yet: asking for one here would make the driver finish the job on this thread
+    m_pending = true;
+}
+
+bool ShaderProgram::poll()
+{
+    if (!m_pending) return true;
+    
+    if (g_gl_extensions.parallel_shader_compile)
+    {
+        GLint complete = GL_FALSE;
+        glGetProgramiv(m_program_id, GL_COMPLETION_STATUS_KHR, &complete);
+        if (complete == GL_FALSE) return false;
+    }
+    
+    wait();
+    return true;
+}
+
+void ShaderProgram::wait()
+{
+    if (!m_pending) return;
+    m_pending = false;
+    
+    report_compile_errors(m_vertex_shader);
+    report_compile_errors(m_fragment_shader);
+    
     GLint link_success;
     glGetProgramiv(m_program_id, GL_LINK_STATUS, &link_success);
     
@@ -22,27 +89,53 @@ void ShaderProgram::load(const char *vertex_shader_file, const char *fragment_sh
     {
         printf("Error linking shader program!\n");
     }
+    else g_shader_cache.store(m_program_id, m_source_hash);
     
+    locate_variables();
+}
+
+void ShaderProgram::locate_variables()
+{
     m_model_matrix_uniform      = glGetUniformLocation(m_program_id, "modelMatrix");
+    m_model_linear_uniform      = glGetUniformLocation(m_program_id, "modelLinear");
+    m_model_translation_uniform = glGetUniformLocation(m_program_id, "modelTranslation");
     m_projection_matrix_uniform = glGetUniformLocation(m_program_id, "projectionMatrix");
     m_view_matrix_uniform       = glGetUniformLocation(m_program_id, "viewMatrix");
     m_colour_uniform            = glGetUniformLocation(m_program_id, "color");
+    m_uv_rect_uniform           = glGetUniformLocation(m_program_id, "uvRect");
     
     m_position_attribute  = glGetAttribLocation(m_program_id, "position");
     m_tex_coord_attribute = glGetAttribLocation(m_program_id, "texCoord");
     
+    m_instance_linear_attribute      = glGetAttribLocation(m_program_id, "instanceLinear");
+    m_instance_translation_attribute = glGetAttribLocation(m_program_id, "instanceTranslation");
+    m_instance_uv_rect_attribute = glGetAttribLocation(m_program_id, "instanceUvRect");
+    m_instance_tint_attribute    = glGetAttribLocation(m_program_id, "instanceTint");
+    
+    if (g_gl_extensions.uniform_buffer_object)
+    {
+        GLuint camera_block = g_gl_extensions.get_uniform_block_index(m_program_id, "Camera");
+        if (camera_block != GL_INVALID_INDEX)
+            g_gl_extensions.uniform_block_binding(m_program_id, camera_block, Camera::BINDING_POINT);
+    }
+    
+    invalidate_uniform_cache();
+    
     set_colour(1.0f, 1.0f, 1.0f, 1.0f);
+    set_uv_rect(glm::vec4(0.0f, 0.0f, 1.0f, 1.0f));
     
 }
 
 void ShaderProgram::cleanup()
 {
+    if (s_bound_program == m_program_id) s_bound_program = 0;
+    
     glDeleteProgram(m_program_id);
     glDeleteShader(m_vertex_shader);
     glDeleteShader(m_fragment_shader);
 }
 
-GLuint ShaderProgram::load_shader_from_file(const std::string &shaderFile, GLenum type)
+std::string ShaderProgram::read_shader_file(const std::string &shaderFile)
 {
     //Open a file stream with the file name
     std::ifstream infile(shaderFile);
@@ -55,23 +148,29 @@ GLuint ShaderProgram::load_shader_from_file(const std::string &shaderFile, GLenu
     std::stringstream buffer;
     buffer << infile.rdbuf();
     
-    // Load the shader from the contents of the file
-    return load_shader_from_string(buffer.str(), type);
+    return buffer.str();
 }
 
-GLuint ShaderProgram::load_shader_from_string(const std::string &shaderContents, GLenum type)
+GLuint ShaderProgram::load_shader_from_string(std::string_view shaderContents, GLenum type)
 {
     // Create a shader of specified type
     GLuint shaderID = glCreateShader(type);
     
-    // Get the pointer to the C string from the STL string
-    const char *shader_string  = shaderContents.c_str();
-    GLint shader_string_length = (GLint) shaderContents.size();
+    // glShaderSource takes explicit lengths, so neither part needs to be null-terminated
+    std::string_view preamble = shader_preamble();
+    const char *shader_strings[]        = { preamble.data(), shaderContents.data() };
+    GLint       shader_string_lengths[] = { (GLint) preamble.size(), (GLint) shaderContents.size() };
     
     // Set the shader source to the string and compile shader
-    glShaderSource(shaderID, 1, &shader_string, &shader_string_length);
+    glShaderSource(shaderID, 2, shader_strings, shader_string_lengths);
     glCompileShader(shaderID);
     
+    // return the shader id
+    return shaderID;
+}
+
+void ShaderProgram::report_compile_errors(GLuint shaderID)
+{
     // Check if the shader compiled properly
     GLint compile_success;
     glGetShaderiv(shaderID, GL_COMPILE_STATUS, &compile_success);
@@ -83,31 +182,134 @@ GLuint ShaderProgram::load_shader_from_string(const std::string &shaderContents,
         glGetShaderInfoLog(shaderID, sizeof(messages), 0, &messages[0]);
         std::cout << messages << std::endl;
     }
+}
+
+void ShaderProgram::invalidate_uniform_cache()
+{
+    m_model_matrix_valid      = false;
+    m_model_transform_valid   = false;
+    m_view_matrix_valid       = false;
+    m_projection_matrix_valid = false;
+    m_colour_valid            = false;
+    m_uv_rect_valid           = false;
+    m_camera_revision         = 0;
+}
+
+void ShaderProgram::use()
+{
+    if (s_bound_program == m_program_id)
+    {
+        s_counters.program_binds_skipped++;
+    }
+    else
+    {
+        glUseProgram(m_program_id);
+        s_bound_program = m_program_id;
+        s_counters.program_binds_issued++;
+    }
     
-    // return the shader id
-    return shaderID;
+    sync_camera();
+}
+
+void ShaderProgram::sync_camera()
+{
+    if (s_camera == nullptr || s_camera->uses_uniform_buffer() || m_camera_revision == s_camera->get_revision()) return;
+    
+    // Recorded first: the setters below call use() again
+    m_camera_revision = s_camera->get_revision();
+    set_view_matrix(s_camera->get_view_matrix());
+    set_projection_matrix(s_camera->get_projection_matrix());
 }
 
 void ShaderProgram::set_colour(float red, float green, float blue, float alpha)
 {
-    glUseProgram(m_program_id);
+    glm::vec4 colour(red, green, blue, alpha);
+    if (m_colour_valid && m_colour == colour)
+    {
+        s_counters.uniforms_skipped++;
+        return;
+    }
+    
+    use();
     glUniform4f(m_colour_uniform, red, green, blue, alpha);
+    m_colour       = colour;
+    m_colour_valid = true;
+    s_counters.uniforms_issued++;
+}
+
+void ShaderProgram::set_uv_rect(const glm::vec4 &uv_rect)
+{
+    if (m_uv_rect_valid && m_uv_rect == uv_rect)
+    {
+        s_counters.uniforms_skipped++;
+        return;
+    }
+    
+    use();
+    glUniform4f(m_uv_rect_uniform, uv_rect.x, uv_rect.y, uv_rect.z, uv_rect.w);
+    m_uv_rect       = uv_rect;
+    m_uv_rect_valid = true;
+    s_counters.uniforms_issued++;
 }
 
 void ShaderProgram::set_view_matrix(const glm::mat4 &matrix)
 {
-    glUseProgram(m_program_id);
+    if (m_view_matrix_valid && m_view_matrix == matrix)
+    {
+        s_counters.uniforms_skipped++;
+        return;
+    }
+    
+    use();
     glUniformMatrix4fv(m_view_matrix_uniform, 1, GL_FALSE, &matrix[0][0]);
+    m_view_matrix       = matrix;
+    m_view_matrix_valid = true;
+    s_counters.uniforms_issued++;
 }
 
 void ShaderProgram::set_model_matrix(const glm::mat4 &matrix)
 {
-    glUseProgram(m_program_id);
+    if (m_model_matrix_valid && m_model_matrix == matrix)
+    {
+        s_counters.uniforms_skipped++;
+        return;
+    }
+    
+    use();
     glUniformMatrix4fv(m_model_matrix_uniform, 1, GL_FALSE, &matrix[0][0]);
+    m_model_matrix       = matrix;
+    m_model_matrix_valid = true;
+    s_counters.uniforms_issued++;
+}
+
+void ShaderProgram::set_model_transform(const Transform2D &transform)
+{
+    if (m_model_transform_valid && m_model_transform.linear == transform.linear &&
+        m_model_transform.translation == transform.translation)
+    {
+        s_counters.uniforms_skipped++;
+        return;
+    }
+    
+    use();
+    glUniform4fv(m_model_linear_uniform, 1, &transform.linear[0]);
+    glUniform3fv(m_model_translation_uniform, 1, &transform.translation[0]);
+    m_model_transform       = transform;
+    m_model_transform_valid = true;
+    s_counters.uniforms_issued++;
 }
 
 void ShaderProgram::set_projection_matrix(const glm::mat4 &matrix)
 {
-    glUseProgram(m_program_id);
+    if (m_projection_matrix_valid && m_projection_matrix == matrix)
+    {
+        s_counters.uniforms_skipped++;
+        return;
+    }
+    
+    use();
     glUniformMatrix4fv(m_projection_matrix_uniform, 1, GL_FALSE, &matrix[0][0]);
+    m_projection_matrix       = matrix;
+    m_projection_matrix_valid = true;
+    s_counters.uniforms_issued++;
 }
@@ -6,44 +6,133 @@
 #define GL_GLEXT_PROTOTYPES 1
 #include <SDL_opengl.h>
 #include <string>
+#include <string_view>
+#include <cstdint>
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include "glm/mat4x4.hpp"
+#include "glm/vec4.hpp"
+#include "Camera.h"
+#include "Transform2D.h"
 
 class ShaderProgram
 {
+public:
+    // How many binds and uniform uploads reached GL versus were filtered out as redundant
+    struct StateCounters
+    {
+        int program_binds_issued  = 0;
+        int program_binds_skipped = 0;
+        int uniforms_issued       = 0;
+        int uniforms_skipped      = 0;
+    };
+
 private:
     void cleanup();
+    void invalidate_uniform_cache();
+    void sync_camera();
     
-    GLuint load_shader_from_string(const std::string &shader_contents, GLenum shader_type);
-    GLuint load_shader_from_file(const std::string &shader_file, GLenum shader_type);
+    void locate_variables();
+    void report_compile_errors(GLuint shader);
+    
+    GLuint load_shader_from_string(std::string_view shader_contents, GLenum shader_type);
 
     GLuint m_program_id;
 
     GLuint m_projection_matrix_uniform;
     GLuint m_model_matrix_uniform;
+    GLuint m_model_linear_uniform;
+    GLuint m_model_translation_uniform;
     GLuint m_view_matrix_uniform;
     GLuint m_colour_uniform;
+    GLuint m_uv_rect_uniform;
 
     GLuint m_position_attribute;
     GLuint m_tex_coord_attribute;
+    
+    // Only present in the instanced shader variants; -1 otherwise
+    GLint m_instance_linear_attribute;
+    GLint m_instance_translation_attribute;
+    GLint m_instance_uv_rect_attribute;
+    GLint m_instance_tint_attribute;
 
     GLuint m_vertex_shader;
     GLuint m_fragment_shader;
     
+    // Set between submit() and the point where the link result has been collected
+    bool     m_pending     = false;
+    uint64_t m_source_hash = 0;
+    
+    // ————— SHADOW STATE ————— //
+    // Last values uploaded to this program; GL keeps uniforms per program, so these stay valid across binds
+    glm::mat4 m_model_matrix,
+              m_view_matrix,
+              m_projection_matrix;
+    glm::vec4 m_colour,
+              m_uv_rect;
+    Transform2D m_model_transform;
+    
+    bool m_model_matrix_valid      = false,
+         m_model_transform_valid   = false,
+         m_view_matrix_valid       = false,
+         m_projection_matrix_valid = false,
+         m_colour_valid            = false,
+         m_uv_rect_valid           = false;
+    
+    // GL has a single current program, so this is shared by every instance
+    static GLuint        s_bound_program;
+    static StateCounters s_counters;
+    
+    static const Camera *s_camera;
+    // Camera revision this program's view/projection uniforms were last synced to
+    unsigned int m_camera_revision = 0;
+    
 public:
 
     void load(const char *vertex_shader_file, const char *fragment_shader_file);
+    // Same as load(), for sources that are already in memory (e.g. EmbeddedShaders.h); nothing is read from disk
+    void load_from_memory(std::string_view vertex_source, std::string_view fragment_source);
+    
+    static std::string read_shader_file(const std::string &shader_file);
+    
+    // ————— ASYNCHRONOUS BUILDS ————— //
+    // submit() hands compiling and linking to the driver and returns at once. poll() never blocks
+    // when GL_KHR_parallel_shader_compile is available (without it, it finishes the build on the
+    // spot); wait() always blocks. The program must not be used before one of them reports it done
+    void submit(std::string_view vertex_source, std::string_view fragment_source);
+    bool poll();
+    void wait();
+    bool const is_ready() const { return !m_pending; }
+
+    // Binds the program unless it is already current, then catches up with the camera if it moved
+    void use();
 
     void set_model_matrix(const glm::mat4 &matrix);
+    // For sprite shaders, which take the model transform as modelLinear + modelTranslation
+    void set_model_transform(const Transform2D &transform);
     void set_projection_matrix(const glm::mat4 &matrix);
     void set_view_matrix(const glm::mat4 &matrix);
     void set_colour(float red, float green, float blue, float alpha);
+    void set_uv_rect(const glm::vec4 &uv_rect);
     
     GLuint const get_program_id()               const { return m_program_id;          };
     GLuint const get_position_attribute()       const { return m_position_attribute;  };
     GLuint const get_tex_coordinate_attribute() const { return m_tex_coord_attribute; };
+    GLint  const get_instance_linear_attribute()      const { return m_instance_linear_attribute;      };
+    GLint  const get_instance_translation_attribute() const { return m_instance_translation_attribute; };
+    GLint  const get_instance_uv_rect_attribute() const { return m_instance_uv_rect_attribute; };
+    GLint  const get_instance_tint_attribute()    const { return m_instance_tint_attribute;    };
+    
+    void set_program_id(GLuint program_id) { m_program_id = program_id; invalidate_uniform_cache(); };
+    
+    // ————— STATE TRACKING ————— //
+    // Call after anything outside ShaderProgram issues glUseProgram
+    static void invalidate_bound_program() { s_bound_program = 0; }
+    
+    // Every program takes its view and projection from this camera
+    static void set_camera(const Camera *camera) { s_camera = camera; }
     
-    void set_program_id(GLuint program_id)                         { m_program_id = program_id;                   };
+    static StateCounters const get_state_counters() { return s_counters;    }
+    static void reset_state_counters()              { s_counters = StateCounters(); }
 };
@@ -0,0 +1,105 @@
+#define GL_SILENCE_DEPRECATION
+
+#include "SpriteBatch.h"
+#include <cstddef>
+
+void SpriteBatch::initialise()
+{
+    m_vertices.reserve(MAX_SPRITES * VERTICES_PER_QUAD);
+
+    glGenBuffers(1, &m_vertex_buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, m_vertex_buffer);
+    glBufferData(GL_ARRAY_BUFFER, MAX_SPRITES * VERTICES_PER_QUAD * sizeof(SpriteVertex),
+                 nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void SpriteBatch::cleanup()
+{
+    glDeleteBuffers(1, &m_vertex_buffer);
+    m_vertex_buffer = 0;
+    m_vertices.clear();
+}
+
+void SpriteBatch::begin(ShaderProgram *program)
+{
+    m_program         = program;
+    m_current_texture = 0;
+    m_draw_calls      = 0;
+    m_sprite_count    = 0;
+    m_vertices.clear();
+
+    m_program->use();
+
+    // Quads are transformed on the CPU, so the model transform stays at identity
+    m_program->set_model_transform(Transform2D());
+}
+
+void SpriteBatch::draw(GLuint texture_id, const Transform2D &transform, const glm::vec4 &uv_rect)
+{
+    if (texture_id != m_current_texture ||
+        m_vertices.size() + VERTICES_PER_QUAD > MAX_SPRITES * VERTICES_PER_QUAD)
+    {
+        flush();
+        m_current_texture = texture_id;
+    }
+
+    // Same winding and UV orientation as Entity::render
+    glm::vec2 bottom_left  = transform.apply(-0.5f, -0.5f);
+    glm::vec2 bottom_right = transform.apply( 0.5f, -0.5f);
+    glm::vec2 top_right    = transform.apply( 0.5f,  0.5f);
+    glm::vec2 top_left     = transform.apply(-0.5f,  0.5f);
+
+    float depth = transform.translation.z;
+
+    float u_left   = uv_rect.x,
+          u_right  = uv_rect.x + uv_rect.z,
+          v_top    = uv_rect.y,
+          v_bottom = uv_rect.y + uv_rect.w;
+
+    m_vertices.push_back({ bottom_left.x,  bottom_left.y,  depth, u_left,  v_bottom });
+    m_vertices.push_back({ bottom_right.x, bottom_right.y, depth, u_right, v_bottom });
+    m_vertices.push_back({ top_right.x,    top_right.y,    depth, u_right, v_top    });
+    m_vertices.push_back({ bottom_left.x,  bottom_left.y,  depth, u_left,  v_bottom });
+    m_vertices.push_back({ top_right.x,    top_right.y,    depth, u_right, v_top    });
+    m_vertices.push_back({ top_left.x,     top_left.y,     depth, u_left,  v_top    });
+
+    m_sprite_count++;
+}
+
+void SpriteBatch::end()
+{
+    flush();
+    m_program = nullptr;
+}
+
+void SpriteBatch::flush()
+{
+    if (m_vertices.empty()) return;
+
+    m_program->use();
+    glBindTexture(GL_TEXTURE_2D, m_current_texture);
+    glBindBuffer(GL_ARRAY_BUFFER, m_vertex_buffer);
+
+    // Orphan the previous contents so the driver doesn't stall on a buffer still in flight
+    GLsizeiptr byte_count = m_vertices.size() * sizeof(SpriteVertex);
+    glBufferData(GL_ARRAY_BUFFER, MAX_SPRITES * VERTICES_PER_QUAD * sizeof(SpriteVertex),
+                 nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, byte_count, m_vertices.data());
+
+    glVertexAttribPointer(m_program->get_position_attribute(), 3, GL_FLOAT, false,
+                          sizeof(SpriteVertex), (const void *) offsetof(SpriteVertex, x));
+    glEnableVertexAttribArray(m_program->get_position_attribute());
+    glVertexAttribPointer(m_program->get_tex_coordinate_attribute(), 2, GL_FLOAT, false,
+                          sizeof(SpriteVertex), (const void *) offsetof(SpriteVertex, u));
+    glEnableVertexAttribArray(m_program->get_tex_coordinate_attribute());
+
+    glDrawArrays(GL_TRIANGLES, 0, (GLsizei) m_vertices.size());
+
+    glDisableVertexAttribArray(m_program->get_position_attribute());
+    glDisableVertexAttribArray(m_program->get_tex_coordinate_attribute());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    m_vertices.clear();
+    m_draw_calls++;
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#ifdef _WINDOWS
+    #include <GL/glew.h>
+#endif
+#define GL_GLEXT_PROTOTYPES 1
+#include <SDL_opengl.h>
+#include <vector>
+#include "glm/mat4x4.hpp"
+#include "glm/vec4.hpp"
+#include "ShaderProgram.h"
+#include "Transform2D.h"
+
+struct SpriteInstance
+{
+    Transform2D transform;
+    glm::vec4 uv_rect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+    glm::vec4 tint    = glm::vec4(1.0f);
+};
+
+// Sprites sharing one texture whose per-instance data lives in a GPU buffer,
+// so the whole set draws with a single instanced call
+class SpriteInstanceGroup
+{
+private:
+    GLuint m_texture_id      = 0;
+    GLuint m_instance_buffer = 0;
+
+    std::vector<SpriteInstance> m_instances;
+
+    unsigned int m_source_revision = 0;
+
+public:
+    // source_revision identifies the state the instances were built from, so the owner can tell
+    // when they have gone stale
+    void set_instances(GLuint texture_id, const std::vector<SpriteInstance> &instances,
+                       unsigned int source_revision = 0);
+    void cleanup();
+
+    // ————— GETTERS ————— //
+    GLuint const get_texture_id()      const { return m_texture_id;      }
+    GLuint const get_instance_buffer() const { return m_instance_buffer; }
+    int    const get_instance_count()  const { return (int) m_instances.size(); }
+    unsigned int const get_source_revision() const { return m_source_revision; }
+    std::vector<SpriteInstance> const &get_instances() const { return m_instances; }
+};
+
+class SpriteRenderer
+{
+private:
+    struct QuadVertex
+    {
+        float x, y;
+        float u, v;
+    };
+
+    void bind_attributes();
+    void unbind_attributes();
+
+    ShaderProgram *m_program = nullptr;
+
+    GLuint m_vertex_array  = 0;
+    GLuint m_vertex_buffer = 0;
+    GLuint m_index_buffer  = 0;
+
+    bool m_bound = false;
+
+public:
+    // ————— STATIC VARIABLES ————— //
+    static constexpr int INDICES_PER_QUAD         = 6;
+    static constexpr int INSTANCE_ATTRIBUTE_COUNT = 4;
+
+    // ————— METHODS ————— //
+    // The unit quad lives in GPU buffers for the lifetime of the renderer; the
+    // attribute layout is recorded against the given program's locations
+    void initialise(ShaderProgram *program);
+    void cleanup();
+
+    // Sprites only change the model transform and UV rectangle between draws
+    void begin();
+    void draw(GLuint texture_id, const Transform2D &transform, const glm::vec4 &uv_rect);
+    void end();
+
+    // Uses glDrawElementsInstanced with the given instanced program when the context
+    // supports it, and falls back to one draw per instance otherwise
+    void draw_instanced(ShaderProgram *instanced_program, const SpriteInstanceGroup &group);
+
+    // ————— GETTERS ————— //
+    ShaderProgram* const get_program() const { return m_program; }
+};
@@ -0,0 +1,96 @@
+#define GL_SILENCE_DEPRECATION
+
+#include "StaticLayer.h"
+#include "Entity.h"
+#include "GLExtensions.h"
+#include "Transform2D.h"
+
+bool StaticLayer::initialise(int width, int height)
+{
+    if (!g_gl_extensions.framebuffer_object) return false;
+    
+    m_width  = width;
+    m_height = height;
+    
+    glGenTextures(1, &m_texture_id);
+    glBindTexture(GL_TEXTURE_2D, m_texture_id);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    
+    // Composited texel-for-pixel, so no filtering or mipmaps are ever needed
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    
+    g_gl_extensions.gen_framebuffers(1, &m_framebuffer);
+    g_gl_extensions.bind_framebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    g_gl_extensions.framebuffer_texture_2d(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_texture_id, 0);
+    
+    bool complete = g_gl_extensions.check_framebuffer_status(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    g_gl_extensions.bind_framebuffer(GL_FRAMEBUFFER, 0);
+    
+    if (!complete)
+    {
+        cleanup();
+        return false;
+    }
+    
+    m_valid = false;
+    return true;
+}
+
+void StaticLayer::cleanup()
+{
+    if (m_framebuffer != 0) g_gl_extensions.delete_framebuffers(1, &m_framebuffer);
+    if (m_texture_id != 0) glDeleteTextures(1, &m_texture_id);
+    
+    m_framebuffer = 0;
+    m_texture_id  = 0;
+    m_valid       = false;
+}
+
+unsigned int const StaticLayer::content_revision() const
+{
+    // Revisions only ever grow, so the sum changes whenever any one of them does
+    unsigned int revision = 0;
+    for (const Entity *entity : m_entities) revision += entity->get_revision();
+    return revision;
+}
+
+bool const StaticLayer::needs_capture() const
+{
+    return !m_valid || content_revision() != m_captured_revision;
+}
+
+void StaticLayer::begin_capture()
+{
+    glGetIntegerv(GL_VIEWPORT, m_previous_viewport);
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &m_previous_framebuffer);
+    
+    g_gl_extensions.bind_framebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    glViewport(0, 0, m_width, m_height);
+    glClear(GL_COLOR_BUFFER_BIT);
+}
+
+void StaticLayer::end_capture()
+{
+    g_gl_extensions.bind_framebuffer(GL_FRAMEBUFFER, m_previous_framebuffer);
+    glViewport(m_previous_viewport[0], m_previous_viewport[1], m_previous_viewport[2], m_previous_viewport[3]);
+    
+    m_captured_revision = content_revision();
+    m_valid             = true;
+    m_capture_count++;
+}
+
+void StaticLayer::composite(SpriteRenderer *renderer, const glm::vec3 &centre, const glm::vec2 &size) const
+{
+    Transform2D transform;
+    transform.linear      = glm::vec4(size.x, 0.0f, 0.0f, size.y);
+    transform.translation = centre;
+    
+    // Row 0 of a render target is the bottom of the screen, the opposite of a loaded image
+    GLboolean blending = glIsEnabled(GL_BLEND);
+    glDisable(GL_BLEND);
+    renderer->draw(m_texture_id, transform, glm::vec4(0.0f, 1.0f, 1.0f, -1.0f));
+    if (blending) glEnable(GL_BLEND);
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#ifdef _WINDOWS
+    #include <GL/glew.h>
+#endif
+#define GL_GLEXT_PROTOTYPES 1
+#include <SDL_opengl.h>
+#include <vector>
+#include "glm/vec2.hpp"
+#include "glm/vec3.hpp"
+#include "SpriteRenderer.h"
+
+class Entity;
+
+// Entities that never move are drawn once into an offscreen texture at window resolution,
+// then every frame costs a single opaque full-screen quad, however many of them there are
+class StaticLayer
+{
+private:
+    std::vector<const Entity*> m_entities;
+
+    GLuint m_framebuffer = 0;
+    GLuint m_texture_id  = 0;
+    int    m_width       = 0,
+           m_height      = 0;
+
+    GLint  m_previous_viewport[4];
+    GLint  m_previous_framebuffer = 0;
+
+    bool         m_valid             = false;
+    unsigned int m_captured_revision = 0;
+    int          m_capture_count     = 0;
+
+    unsigned int const content_revision() const;
+
+public:
+    // ————— METHODS ————— //
+    // False when the context has no framebuffer objects; callers then draw the entities directly
+    bool initialise(int width, int height);
+    void cleanup();
+
+    // A change to any tracked entity's transform or texture forces the next capture
+    void track(const Entity *entity) { m_entities.push_back(entity); m_valid = false; }
+    void invalidate() { m_valid = false; }
+
+    bool const needs_capture() const;
+
+    // Everything drawn in between lands in the layer instead of the window
+    void begin_capture();
+    void end_capture();
+
+    // Covers the given region of the world, normally the whole view, with blending off.
+    // centre.z is the depth the layer is drawn at
+    void composite(SpriteRenderer *renderer, const glm::vec3 &centre, const glm::vec2 &size) const;
+
+    // ————— GETTERS ————— //
+    bool   const is_initialised()    const { return m_framebuffer != 0; }
+    GLuint const get_texture_id()    const { return m_texture_id;       }
+    int    const get_capture_count() const { return m_capture_count;    }
+};
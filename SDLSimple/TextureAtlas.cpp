@@ -0,0 +1,260 @@
+#define GL_SILENCE_DEPRECATION
+
+#include "TextureAtlas.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <iostream>
+
+void TextureAtlas::add(const char *filepath, int max_width, int max_height)
+{
+    for (PendingImage &pending : m_pending)
+    {
+        if (pending.path != filepath) continue;
+        
+        // Shared by several sprites: keep enough resolution for the largest of them
+        pending.max_width  = (pending.max_width  == 0 || max_width  == 0) ? 0 : std::max(pending.max_width,  max_width);
+        pending.max_height = (pending.max_height == 0 || max_height == 0) ? 0 : std::max(pending.max_height, max_height);
+        return;
+    }
+    
+    m_pending.push_back({ filepath, max_width, max_height });
+}
+
+void TextureAtlas::build(FilterType filter_type, AssetLoader *loader)
+{
+    GLint max_texture_size = PAGE_SIZE;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max_texture_size);
+    m_page_size = std::min(PAGE_SIZE, (int) max_texture_size);
+    
+    std::vector<Image> images(m_pending.size());
+    std::vector<int>   order;
+    
+    if (loader != nullptr)
+    {
+        // Submit everything before waiting on anything, so the wait is as long as the slowest image
+        std::vector<std::future<Image>> decodes;
+        for (const PendingImage &pending : m_pending)
+            decodes.push_back(loader->decode(pending.path, pending.max_width, pending.max_height));
+        
+        for (int i = 0; i < (int) decodes.size(); i++)
+        {
+            images[i] = decodes[i].get();
+            if (images[i].width > 0) order.push_back(i);
+        }
+    }
+    else
+    {
+        for (int i = 0; i < (int) m_pending.size(); i++)
+        {
+            if (!load_image(m_pending[i].path.c_str(), images[i])) continue;
+            
+            downscale_to_fit(images[i], m_pending[i].max_width, m_pending[i].max_height);
+            order.push_back(i);
+        }
+    }
+    
+    // Tallest first keeps the skyline flat, which is what makes bottom-left packing tight
+    std::sort(order.begin(), order.end(), [&images](int a, int b)
+    {
+        return images[a].height != images[b].height ? images[a].height > images[b].height
+                                                     : images[a].width  > images[b].width;
+    });
+    
+    std::vector<Placement> placements;
+    for (int index : order)
+    {
+        int width  = images[index].width  + PADDING * 2,
+            height = images[index].height + PADDING * 2;
+        
+        if (width > m_page_size || height > m_page_size)
+        {
+            std::cout << "Atlas: " << m_pending[index].path << " is larger than a page, leaving it out" << std::endl;
+            continue;
+        }
+        
+        int page_index = 0, x = 0, y = 0;
+        for (; page_index < (int) m_pages.size(); page_index++)
+            if (pack(m_pages[page_index], width, height, x, y)) break;
+        
+        if (page_index == (int) m_pages.size())
+        {
+            m_pages.emplace_back();
+            m_pages.back().skyline.push_back({ 0, 0, m_page_size });
+            pack(m_pages.back(), width, height, x, y);
+        }
+        
+        placements.push_back({ m_pending[index].path, page_index, x, y, width, height });
+    }
+    
+    // Pages are only as large as what was packed into them
+    for (Page &page : m_pages)
+    {
+        page.image.width  = page.used_width;
+        page.image.height = page.used_height;
+        page.image.pixels.assign((std::size_t) page.used_width * page.used_height * Image::BYTES_PER_PIXEL, 0);
+    }
+    
+    for (int i = 0; i < (int) order.size(); i++)
+    {
+        const std::string &path = m_pending[order[i]].path;
+        auto placement = std::find_if(placements.begin(), placements.end(),
+                                      [&path](const Placement &p) { return p.path == path; });
+        if (placement == placements.end()) continue;
+        
+        Page &page = m_pages[placement->page];
+        blit(page, images[order[i]], placement->x + PADDING, placement->y + PADDING);
+        
+        AtlasRegion region;
+        region.opaque  = is_opaque(images[order[i]].view());
+        region.uv_rect = glm::vec4((float) (placement->x + PADDING) / page.used_width,
+                                   (float) (placement->y + PADDING) / page.used_height,
+                                   (float) images[order[i]].width  / page.used_width,
+                                   (float) images[order[i]].height / page.used_height);
+        m_regions[path] = region;
+        
+        // Release the decoded source as soon as it has been copied into its page
+        images[order[i]] = Image();
+    }
+    
+    TextureOptions options;
+    options.filter_type    = filter_type;
+    options.wrap_mode      = GL_CLAMP_TO_EDGE;
+    options.max_mip_levels = MIP_LEVELS;
+    
+    for (int page_index = 0; page_index < (int) m_pages.size(); page_index++)
+    {
+        Page &page = m_pages[page_index];
+        
+        std::size_t byte_size = 0;
+        page.texture_id   = TextureManager::create_texture(page.image, options, &byte_size);
+        m_resident_bytes += byte_size;
+        page.image = Image();
+        
+        for (const Placement &placement : placements)
+            if (placement.page == page_index) m_regions[placement.path].texture_id = page.texture_id;
+    }
+    
+    m_pending.clear();
+}
+
+void TextureAtlas::cleanup()
+{
+    for (Page &page : m_pages) glDeleteTextures(1, &page.texture_id);
+    
+    m_pages.clear();
+    m_regions.clear();
+    m_pending.clear();
+    m_resident_bytes = 0;
+}
+
+AtlasRegion const TextureAtlas::get_region(const char *filepath) const
+{
+    auto region = m_regions.find(filepath);
+    return region == m_regions.end() ? AtlasRegion() : region->second;
+}
+
+bool TextureAtlas::find_position(const Page &page, int width, int height,
+                                 int &best_x, int &best_y, int &best_node) const
+{
+    int best_top = INT_MAX;
+    best_node = -1;
+    
+    for (int i = 0; i < (int) page.skyline.size(); i++)
+    {
+        int x = page.skyline[i].x;
+        if (x + width > m_page_size) break;
+        
+        // The rectangle rests on the highest segment it spans
+        int y = 0, remaining = width;
+        for (int j = i; remaining > 0; j++)
+        {
+            y = std::max(y, page.skyline[j].y);
+            remaining -= page.skyline[j].width;
+        }
+        
+        if (y + height > m_page_size) continue;
+        
+        if (y + height < best_top || (y + height == best_top && x < best_x))
+        {
+            best_top  = y + height;
+            best_x    = x;
+            best_y    = y;
+            best_node = i;
+        }
+    }
+    
+    return best_node >= 0;
+}
+
+void TextureAtlas::insert_skyline(Page &page, int node, int x, int y, int width, int height)
+{
+    page.skyline.insert(page.skyline.begin() + node, { x, y + height, width });
+    
+    // Trim or drop the segments now covered by the new one
+    for (int i = node + 1; i < (int) page.skyline.size(); i++)
+    {
+        SkylineNode &previous = page.skyline[i - 1];
+        SkylineNode &current  = page.skyline[i];
+        
+        int overlap = previous.x + previous.width - current.x;
+        if (overlap <= 0) break;
+        
+        current.x     += overlap;
+        current.width -= overlap;
+        
+        if (current.width > 0) break;
+        
+        page.skyline.erase(page.skyline.begin() + i);
+        i--;
+    }
+    
+    for (int i = 0; i + 1 < (int) page.skyline.size(); i++)
+    {
+        if (page.skyline[i].y == page.skyline[i + 1].y)
+        {
+            page.skyline[i].width += page.skyline[i + 1].width;
+            page.skyline.erase(page.skyline.begin() + i + 1);
+            i--;
+        }
+    }
+}
+
+bool TextureAtlas::pack(Page &page, int width, int height, int &x, int &y)
+{
+    int node;
+    if (!find_position(page, width, height, x, y, node)) return false;
+    
+    insert_skyline(page, node, x, y, width, height);
+    
+    page.used_width  = std::max(page.used_width,  x + width);
+    page.used_height = std::max(page.used_height, y + height);
+    return true;
+}
+
+void TextureAtlas::blit(Page &page, const Image &image, int x, int y)
+{
+    std::size_t row_bytes = (std::size_t) image.width * Image::BYTES_PER_PIXEL;
+    
+    for (int row = 0; row < image.height; row++)
+        std::memcpy(page.image.pixel(x, y + row), image.pixel(0, row), row_bytes);
+    
+    // Extrude the outermost pixels into the padding: columns first, then whole padded rows
+    for (int row = 0; row < image.height; row++)
+    {
+        for (int column = 1; column <= PADDING; column++)
+        {
+            std::memcpy(page.image.pixel(x - column, y + row), image.pixel(0, row), Image::BYTES_PER_PIXEL);
+            std::memcpy(page.image.pixel(x + image.width - 1 + column, y + row),
+                        image.pixel(image.width - 1, row), Image::BYTES_PER_PIXEL);
+        }
+    }
+    
+    std::size_t padded_row_bytes = (std::size_t) (image.width + PADDING * 2) * Image::BYTES_PER_PIXEL;
+    for (int row = 1; row <= PADDING; row++)
+    {
+        std::memcpy(page.image.pixel(x - PADDING, y - row), page.image.pixel(x - PADDING, y), padded_row_bytes);
+        std::memcpy(page.image.pixel(x - PADDING, y + image.height - 1 + row),
+                    page.image.pixel(x - PADDING, y + image.height - 1), padded_row_bytes);
+    }
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#ifdef _WINDOWS
+    #include <GL/glew.h>
+#endif
+#define GL_GLEXT_PROTOTYPES 1
+#include <SDL_opengl.h>
+#include <cstddef>
+#include <future>
+#include <map>
+#include <set>
+#include <string>
+#include "Image.h"
+#include "AssetLoader.h"
+#include "AssetArchive.h"
+#include "KtxTexture.h"
+
+enum FilterType { NEAREST, LINEAR };
+
+struct TextureOptions
+{
+    FilterType filter_type = NEAREST;
+    GLint      wrap_mode   = GL_REPEAT;
+
+    // Largest size the texture is ever drawn at on screen; bigger sources are shrunk at decode time
+    int max_width  = 0;
+    int max_height = 0;
+
+    int max_mip_levels = MAX_MIP_LEVELS;
+
+    static constexpr int MAX_MIP_LEVELS = 16;
+};
+
+class TextureManager
+{
+private:
+    struct TextureRecord
+    {
+        GLuint      texture_id;
+        int         ref_count;
+        std::size_t byte_size;
+        bool        opaque;
+    };
+
+    static std::string make_key(const char *filepath, const TextureOptions &options);
+
+    // has_compressed() results by source path; cooked files don't appear or vanish mid-run
+    static std::map<std::string, bool> s_compressed_paths;
+
+    // Keyed by path and options, since filtering and resolution are baked into the texture object
+    std::map<std::string, TextureRecord> m_textures;
+    std::map<GLuint, std::string>        m_keys_by_id;
+    // Decodes requested through prefetch() that have not been uploaded yet
+    std::map<std::string, std::future<Image>> m_pending;
+    // Paths acquire() uploads without decoding, so repeated prefetches return before probing again
+    std::set<std::string> m_without_decode;
+
+    AssetLoader        *m_loader  = nullptr;
+    const AssetArchive *m_archive = nullptr;
+
+    std::size_t m_resident_bytes = 0;
+
+public:
+    // With a loader, prefetch() hands decoding to its workers; without one it is a no-op
+    void set_loader(AssetLoader *loader) { m_loader = loader; }
+    // Assets found in an open archive are uploaded from its mapping and never decoded
+    void set_archive(const AssetArchive *archive) { m_archive = archive; }
+    // Starts decoding in the background so a later acquire() with the same options only uploads
+    void prefetch(const char *filepath, const TextureOptions &options);
+    // True once acquire() would no longer have to wait on a decode
+    bool is_ready(const char *filepath, const TextureOptions &options) const;
+
+    // Returns the shared texture for this asset, decoding and uploading it only on first use
+    GLuint acquire(const char *filepath, FilterType filter_type);
+    GLuint acquire(const char *filepath, const TextureOptions &options);
+    // Drops one reference; the GL texture is deleted once nobody holds it
+    void release(GLuint texture_id);
+    void release_all();
+
+    // Uploads decoded pixels and their mip chain into a new texture object owned by the caller
+    static GLuint create_texture(const Image &image, const TextureOptions &options,
+                                 std::size_t *byte_size = nullptr);
+    // Uploads the levels of a block-compressed texture that fit the options' size limits
+    static GLuint create_texture(const KtxTexture &texture, const TextureOptions &options,
+                                 std::size_t *byte_size = nullptr);
+    // True when a cooked .ktx2 sits next to the source and the context can sample it
+    static bool has_compressed(const char *filepath);
+    // Same, for a mip chain that already exists (level 0 first)
+    static GLuint create_texture(const ImageView *levels, int level_count, const TextureOptions &options,
+                                 std::size_t *byte_size = nullptr);
+
+    // ————— GETTERS ————— //
+    std::size_t const get_resident_bytes() const { return m_resident_bytes;   }
+    int         const get_texture_count()  const { return (int) m_textures.size(); }
+    int         const get_ref_count(GLuint texture_id) const;
+    // Decided from the alpha channel when the texture was loaded; false for unknown textures
+    bool        const is_opaque(GLuint texture_id) const;
+};
+
+// Handle for a texture that should cost nothing until it is needed. Nothing is
+// decoded until prefetch() (a hint that it will be needed soon) or get() (first use)
+class LazyTexture
+{
+private:
+    TextureManager *m_manager = nullptr;
+    std::string     m_filepath;
+    TextureOptions  m_options;
+
+    GLuint m_texture_id = 0;
+
+public:
+    void set_source(TextureManager *manager, const char *filepath, const TextureOptions &options);
+
+    void prefetch();
+    // Uploads on first call, waiting for the decode only if it has not finished yet
+    GLuint get();
+    void release();
+
+    // ————— GETTERS ————— //
+    bool const is_resident() const { return m_texture_id != 0; }
+    bool const is_ready()    const;
+};
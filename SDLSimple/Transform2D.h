@@ -0,0 +1,58 @@
+#pragma once
+
+#include "glm/mat4x4.hpp"
+#include "glm/vec2.hpp"
+#include "glm/vec3.hpp"
+#include "glm/vec4.hpp"
+
+// Everything a sprite transform needs in 2D: a 2x2 rotation/scale plus a translation,
+// 28 bytes instead of a 64-byte mat4. linear holds the two columns, (m00, m10) and (m01, m11);
+// translation.z is the sprite's depth, which the linear part never touches
+struct Transform2D
+{
+    glm::vec4 linear      = glm::vec4(1.0f, 0.0f, 0.0f, 1.0f);
+    glm::vec3 translation = glm::vec3(0.0f);
+
+    // translate(position) * rotate(angle, axis) * scale(scale), seen from the XY plane, from the
+    // angle's precomputed cosine and sine. The axis must be unit length; any axis but Z
+    // foreshortens the sprite (a half turn about Y mirrors it) instead of spinning it
+    static Transform2D compose(const glm::vec3 &position, float cos_angle, float sin_angle,
+                               const glm::vec3 &axis, const glm::vec3 &scale)
+    {
+        // Upper-left 2x2 of the axis-angle rotation matrix
+        float one_minus_cos = 1.0f - cos_angle;
+        float m00 = cos_angle + one_minus_cos * axis.x * axis.x,
+              m11 = cos_angle + one_minus_cos * axis.y * axis.y,
+              m01 = one_minus_cos * axis.x * axis.y - sin_angle * axis.z,
+              m10 = one_minus_cos * axis.x * axis.y + sin_angle * axis.z;
+
+        Transform2D transform;
+        transform.linear      = glm::vec4(m00 * scale.x, m10 * scale.x, m01 * scale.y, m11 * scale.y);
+        transform.translation = position;
+        return transform;
+    }
+
+    // Blends the position between two fixed steps. The linear part is taken from current as is:
+    // the only rotations here are instant facing flips, which a blend would squash through zero
+    static Transform2D interpolate(const Transform2D &previous, const Transform2D &current, float alpha)
+    {
+        Transform2D transform = current;
+        transform.translation = previous.translation + (current.translation - previous.translation) * alpha;
+        return transform;
+    }
+
+    glm::vec2 const apply(float x, float y) const
+    {
+        return glm::vec2(linear.x * x + linear.z * y + translation.x,
+                         linear.y * x + linear.w * y + translation.y);
+    }
+
+    glm::mat4 const to_mat4() const
+    {
+        glm::mat4 matrix(1.0f);
+        matrix[0] = glm::vec4(linear.x, linear.y, 0.0f, 0.0f);
+        matrix[1] = glm::vec4(linear.z, linear.w, 0.0f, 0.0f);
+        matrix[3] = glm::vec4(translation, 1.0f);
+        return matrix;
+    }
+};
@@ -21,9 +21,28 @@
 #include <SDL_opengl.h>
 #include "glm/mat4x4.hpp"
 #include "glm/gtc/matrix_transform.hpp"
+#include "glm/vec2.hpp"
 #include "ShaderProgram.h"
 #include "stb_image.h"
 #include "Entity.h"
+#include "SpriteBatch.h"
+#include "SpriteRenderer.h"
+#include "GLExtensions.h"
+#include "TextureManager.h"
+#include "TextureAtlas.h"
+#include "AssetLoader.h"
+#include "AssetArchive.h"
+#include "TextureUploader.h"
+#include "ShaderCache.h"
+#include "EmbeddedShaders.h"
+#include "StaticLayer.h"
+#include "RenderQueue.h"
+#include "TripleBuffer.h"
+#include "FramePacer.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <ctime>
 #include "cmath"
@@ -50,7 +69,9 @@ constexpr int VIEWPORT_X = 0,
               VIEWPORT_HEIGHT = WINDOW_HEIGHT;
 
 constexpr char V_SHADER_PATH[] = "shaders/vertex_textured.glsl",
-               F_SHADER_PATH[] = "shaders/fragment_textured.glsl";
+               F_SHADER_PATH[] = "shaders/fragment_textured.glsl",
+               V_INSTANCED_SHADER_PATH[] = "shaders/vertex_instanced.glsl",
+               F_INSTANCED_SHADER_PATH[] = "shaders/fragment_instanced.glsl";
 
 constexpr float MILLISECONDS_IN_SECOND = 1000.0;
 constexpr char SUBMARINE_FILEPATH[] = "assets/submarine.png",
@@ -61,19 +82,63 @@ MISSIONFAIL_FILEPATH[] = "assets/eaten.png";
 
 constexpr char PLATFORM_FILEPATH[]    = "assets/winPlatform.png",
 LOSE_PLATFORM_FILEPATH[] = "assets/losePlatform.png";
+
+constexpr char CACHE_ORGANISATION[] = "CS3113",
+               CACHE_APPLICATION[]  = "Project3";
+
+// Written by tools/cook_assets.cpp; without it every image is decoded from its PNG/JPEG
+constexpr char ASSET_ARCHIVE_FILEPATH[] = "assets/textures.pak";
  
 constexpr glm::vec3 SUBMARINE_INITSCALE = glm::vec3(1.37f, 1.0f, 0.0f),
                     BACKGROUND_INITSCALE = glm::vec3(15.8f, 8.0f, 0.0f),
                     WIN_PLATFORMS_INITSCALE = glm::vec3(1.5f, 1.5f, 0.0f),
                     WIN_MESSAGE_INITSCALE = glm::vec3(4.53f, 3.0f, 0.0f),
                     LOSE_MESSAGE_INITSCALE = glm::vec3(3.93f, 3.0f, 0.0f),
-                    LOSE_PLATFORMS_INITSCALE = glm::vec3(4.5f, 0.5f, 0.0f);
+                    LOSE_PLATFORMS_INITSCALE = glm::vec3(4.5f, 0.5f, 0.0f),
+                    LOSE_PLATFORMS_MAXSCALE = glm::vec3(4.8f, 0.5f, 0.0f); // largest of the hand-placed hazards
+
+// Larger is nearer; the projection's depth range is [-1, 1]. As in the original draw order,
+// the player (and any NPCs) sit behind the platforms
+constexpr float BACKGROUND_DEPTH = -0.9f,
+                PLAYER_DEPTH     = -0.7f,
+                PLATFORM_DEPTH   = -0.5f,
+                MESSAGE_DEPTH    =  0.5f;
+
+constexpr float ORTHO_LEFT   = -5.0f,
+                ORTHO_RIGHT  =  5.0f,
+                ORTHO_BOTTOM = -3.75f,
+                ORTHO_TOP    =  3.75f;
                  
 
 
-constexpr GLint NUMBER_OF_TEXTURES = 1,
-                LEVEL_OF_DETAIL    = 0,
-                TEXTURE_BORDER     = 0;
+// Batching wins once many sprites share a texture; the direct path draws each
+// sprite from the persistent unit quad with only a transform and UV upload
+constexpr bool BATCH_SPRITES = true;
+
+// Platforms never move, so each texture group is uploaded once and drawn with one instanced call
+constexpr bool INSTANCE_STATIC_PLATFORMS = true;
+
+// Gameplay sprites share atlas pages so a frame binds as few textures as possible
+constexpr bool USE_TEXTURE_ATLAS = true;
+
+// The background and platforms are drawn once into an offscreen layer and composited each frame
+constexpr bool CACHE_STATIC_LAYER = true;
+
+// Physics steps on its own thread and hands finished states to the render loop,
+// so a slow buffer swap no longer holds up the simulation or the other way round
+constexpr bool THREADED_SIMULATION = true;
+
+// How the render loop is paced. VSYNC falls back to the limiter at TARGET_FPS when the driver
+// won't sync; UNCAPPED renders as fast as it can
+constexpr PacingMode FRAME_PACING = VSYNC;
+constexpr int TARGET_FPS = 60;
+
+// Once the game has ended nothing moves, so both loops block until input arrives and the
+// window is only redrawn when the system asks for it
+constexpr bool IDLE_WHEN_ENDED = true;
+
+// The end-of-game messages start decoding once the player is this close to any platform
+constexpr float MESSAGE_PREFETCH_MARGIN = 1.0f;
 
 constexpr int PLATFORM_COUNT = 3;
 constexpr int PLATFORM_LOSE_COUNT = 7;
@@ -84,7 +149,35 @@ bool ifLose = false;
 
 // ————— STRUCTS AND ENUMS —————//
 enum AppStatus  { RUNNING, TERMINATED };
-enum FilterType { NEAREST, LINEAR     };
+
+// Coarse draw order, from back to front; depth orders sprites within a layer
+enum RenderLayer { BACKGROUND_LAYER, WORLD_LAYER, OVERLAY_LAYER };
+
+// What the simulation needs from the keyboard, sampled on the thread that owns the window
+struct InputState
+{
+    bool left  = false,
+         right = false,
+         up    = false,
+         down  = false;
+    
+    bool const any() const { return left || right || up || down; }
+};
+
+// Everything the renderer reads that the simulation can change, published once per update
+struct GameSnapshot
+{
+    SpriteSnapshot player;
+    Transform2D    player_previous;
+    
+    // Clock time, in seconds, that the current state corresponds to
+    float step_time = 0.0f;
+    
+    bool game_end      = false,
+         win           = false,
+         lose          = false,
+         near_platform = false;
+};
 
 struct GameState
 {
@@ -101,55 +194,161 @@ struct GameState
 GameState g_game_state;
 
 SDL_Window* g_display_window;
-AppStatus g_app_status = RUNNING;
+std::atomic<AppStatus> g_app_status { RUNNING };
 
 ShaderProgram g_shader_program;
-glm::mat4 g_view_matrix, g_projection_matrix;
+ShaderProgram g_instanced_shader_program;
+SpriteBatch g_sprite_batch;
+SpriteRenderer g_sprite_renderer;
+SpriteInstanceGroup g_win_platform_instances;
+SpriteInstanceGroup g_lose_platform_instances;
+std::vector<Entity*> g_win_platforms;
+std::vector<Entity*> g_lose_platforms;
+TextureManager g_texture_manager;
+LazyTexture g_win_message_texture;
+LazyTexture g_lose_message_texture;
+TextureAtlas g_texture_atlas;
+AssetLoader g_asset_loader;
+AssetArchive g_asset_archive;
+Camera g_camera;
+StaticLayer g_static_layer;
+
+bool g_depth_buffer = false;
+RenderQueue g_render_queue;
+FramePacer g_frame_pacer;
+
+TripleBuffer<GameSnapshot> g_snapshots;
+std::mutex g_input_mutex;
+std::condition_variable g_input_changed;
+InputState g_shared_input;
+
+int g_frames_rendered = 0;
+Entity::TransformCounters g_transform_totals;
 
 float g_previous_ticks = 0.0f;
 
 void initialise();
-void process_input();
+InputState process_input();
 void update();
+void publish_snapshot();
 void render();
 void shutdown();
 
-GLuint load_texture(const char* filepath);
-
 // ———— GENERAL FUNCTIONS ———— //
-GLuint load_texture(const char* filepath, FilterType filterType)
+// Pixels covered on screen by a sprite of this world-space scale under our ortho projection
+glm::ivec2 on_screen_size(glm::vec3 scale)
+{
+    return glm::ivec2((int) std::ceil(std::fabs(scale.x) * VIEWPORT_WIDTH  / (ORTHO_RIGHT - ORTHO_LEFT)),
+                      (int) std::ceil(std::fabs(scale.y) * VIEWPORT_HEIGHT / (ORTHO_TOP - ORTHO_BOTTOM)));
+}
+
+// Shaders compiled into the binary (tools/embed_files.py) win; the files are only read if one is missing
+void submit_shader_program(ShaderProgram& program, const char* vertex_path, const char* fragment_path)
 {
-    int width, height, number_of_components;
-    unsigned char* image = stbi_load(filepath, &width, &height, &number_of_components, STBI_rgb_alpha);
+    const EmbeddedFile *vertex   = find_embedded_file(vertex_path),
+                       *fragment = find_embedded_file(fragment_path);
     
-    if (image == NULL)
+    if (vertex != nullptr && fragment != nullptr)
+    {
+        program.submit({ vertex->data, vertex->size }, { fragment->data, fragment->size });
+    }
+    else
+    {
+        std::string vertex_source   = ShaderProgram::read_shader_file(vertex_path),
+                    fragment_source = ShaderProgram::read_shader_file(fragment_path);
+        program.submit(vertex_source, fragment_source);
+    }
+}
+
+// Keeps the window responsive while the driver finishes whatever is still compiling
+void wait_for_shader_programs(std::initializer_list<ShaderProgram*> programs)
+{
+    bool ready = false;
+    while (!ready)
     {
-        LOG("Unable to load image. Make sure the path is correct.");
-        assert(false);
+        ready = true;
+        for (ShaderProgram* program : programs) ready = program->poll() && ready;
+        
+        if (!ready)
+        {
+            SDL_PumpEvents();
+            SDL_Delay(1);
+        }
     }
+}
+
+// Never keeps more texels than the sprite can show at its largest scale
+TextureOptions texture_options(FilterType filterType, glm::vec3 max_scale)
+{
+    glm::ivec2 size = on_screen_size(max_scale);
     
-    GLuint textureID;
-    glGenTextures(NUMBER_OF_TEXTURES, &textureID);
-    glBindTexture(GL_TEXTURE_2D, textureID);
-    glTexImage2D(GL_TEXTURE_2D, LEVEL_OF_DETAIL, GL_RGBA, width, height, TEXTURE_BORDER,
-                 GL_RGBA, GL_UNSIGNED_BYTE, image);
+    TextureOptions options;
+    options.filter_type = filterType;
+    options.max_width   = size.x;
+    options.max_height  = size.y;
     
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
-                    filterType == NEAREST ? GL_NEAREST : GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER,
-                    filterType == NEAREST ? GL_NEAREST : GL_LINEAR);
+    return options;
+}
+
+void add_to_atlas(const char* filepath, glm::vec3 max_scale)
+{
+    // Atlas pages are assembled from RGBA pixels, so a cooked compressed texture is worth more on its own
+    if (TextureManager::has_compressed(filepath)) return;
     
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glm::ivec2 size = on_screen_size(max_scale);
+    g_texture_atlas.add(filepath, size.x, size.y);
+}
+
+void assign_sprite(Entity* entity, const char* filepath, glm::vec3 max_scale)
+{
+    if (USE_TEXTURE_ATLAS && g_texture_atlas.contains(filepath))
+    {
+        AtlasRegion region = g_texture_atlas.get_region(filepath);
+        entity->set_texture_region(region.texture_id, region.uv_rect);
+        entity->set_opaque(region.opaque);
+        return;
+    }
     
-    stbi_image_free(image);
+    // Entities sharing an image share one GL texture instead of each decoding their own copy
+    entity->set_texture_id(g_texture_manager.acquire(filepath, texture_options(NEAREST, max_scale)));
+    entity->set_opaque(g_texture_manager.is_opaque(entity->get_texture_id()));
+}
+
+unsigned int revision_sum(const std::vector<Entity*>& entities)
+{
+    unsigned int revision = 0;
+    for (Entity* entity : entities) revision += entity->get_revision();
+    return revision;
+}
+
+// All entities in a group must share a texture, which TextureManager guarantees for a shared path
+void build_instance_group(SpriteInstanceGroup& group, const std::vector<Entity*>& entities)
+{
+    std::vector<SpriteInstance> instances;
+    for (Entity* entity : entities)
+    {
+        SpriteInstance instance;
+        instance.transform    = entity->get_transform();
+        instance.uv_rect      = entity->get_current_uv_rect();
+        instances.push_back(instance);
+    }
     
-    return textureID;
+    group.set_instances(entities.front()->get_texture_id(), instances, revision_sum(entities));
+}
+
+// Re-uploads the group once any member has moved or changed texture since it was built
+void refresh_instance_group(SpriteInstanceGroup& group, const std::vector<Entity*>& entities)
+{
+    if (revision_sum(entities) != group.get_source_revision()) build_instance_group(group, entities);
 }
 
 void initialise()
 {
     SDL_Init(SDL_INIT_VIDEO);
+    
+    // Lets opaque sprites reject what they cover before it is shaded
+    SDL_GL_SetAttribute(SDL_GL_DEPTH_SIZE, 16);
+    
     g_display_window = SDL_CreateWindow("Hello, Entities!",
                                       SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
                                       WINDOW_WIDTH, WINDOW_HEIGHT,
@@ -168,17 +367,35 @@ void initialise()
     glewInit();
 #endif
     
-    glViewport(VIEWPORT_X, VIEWPORT_Y, VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
+    int depth_size = 0;
+    SDL_GL_GetAttribute(SDL_GL_DEPTH_SIZE, &depth_size);
+    g_depth_buffer = depth_size > 0;
+    glDepthFunc(GL_LEQUAL);
+    
+    const char* pacing_names[] = { "vsync", "adaptive vsync", "uncapped", "limited" };
+    PacingMode pacing = g_frame_pacer.initialise(FRAME_PACING, TARGET_FPS);
+    LOG("Frame pacing: " << pacing_names[pacing]);
     
-    g_shader_program.load(V_SHADER_PATH, F_SHADER_PATH);
+    load_gl_extensions();
+    g_texture_uploader.initialise();
     
-    g_view_matrix       = glm::mat4(1.0f);
-    g_projection_matrix = glm::ortho(-5.0f, 5.0f, -3.75f, 3.75f, -1.0f, 1.0f);
+    // Program binaries are cached per user, next to wherever SDL keeps preferences
+    char* pref_path = SDL_GetPrefPath(CACHE_ORGANISATION, CACHE_APPLICATION);
+    g_shader_cache.initialise(pref_path);
+    SDL_free(pref_path);
     
-    g_shader_program.set_projection_matrix(g_projection_matrix);
-    g_shader_program.set_view_matrix(g_view_matrix);
+    glViewport(VIEWPORT_X, VIEWPORT_Y, VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
+    
+    // ————— SHADERS ————— //
+    // Every variant is submitted up front; the driver compiles them while the assets below decode
+    submit_shader_program(g_shader_program, V_SHADER_PATH, F_SHADER_PATH);
+    submit_shader_program(g_instanced_shader_program, V_INSTANCED_SHADER_PATH, F_INSTANCED_SHADER_PATH);
     
-    glUseProgram(g_shader_program.get_program_id());
+    // One write here reaches every program, however many there are
+    g_camera.initialise();
+    g_camera.set_view_matrix(glm::mat4(1.0f));
+    g_camera.set_projection_matrix(glm::ortho(ORTHO_LEFT, ORTHO_RIGHT, ORTHO_BOTTOM, ORTHO_TOP, -1.0f, 1.0f));
+    ShaderProgram::set_camera(&g_camera);
     
     glClearColor(BG_RED, BG_BLUE, BG_GREEN, BG_OPACITY);
     
@@ -205,20 +422,63 @@ void initialise()
      );
      
      */
-    GLuint player_texture_id = load_texture(SUBMARINE_FILEPATH, NEAREST);
+    // ————— ASSET DECODING ————— //
+    // Every image is queued on the worker pool before anything waits on one
+    g_asset_loader.start();
+    g_texture_manager.set_loader(&g_asset_loader);
+    
+    if (g_asset_archive.open(ASSET_ARCHIVE_FILEPATH))
+    {
+        g_asset_loader.set_archive(&g_asset_archive);
+        g_texture_manager.set_archive(&g_asset_archive);
+        LOG("Mapped asset archive: " << g_asset_archive.get_entry_count() << " images ("
+            << g_asset_archive.get_mapped_bytes() / (1024 * 1024) << " MB)");
+    }
+    
+    // The messages are only needed when the game ends, so they stay off the startup path
+    g_win_message_texture.set_source(&g_texture_manager, MISSIONACCOMPLISH_FILEPATH,
+                                     texture_options(NEAREST, WIN_MESSAGE_INITSCALE));
+    g_lose_message_texture.set_source(&g_texture_manager, MISSIONFAIL_FILEPATH,
+                                      texture_options(NEAREST, LOSE_MESSAGE_INITSCALE));
+    
+    if (USE_TEXTURE_ATLAS)
+    {
+        add_to_atlas(SUBMARINE_FILEPATH, SUBMARINE_INITSCALE);
+        add_to_atlas(DEEPOCEAN_FILEPATH, BACKGROUND_INITSCALE);
+        add_to_atlas(PLATFORM_FILEPATH, WIN_PLATFORMS_INITSCALE);
+        add_to_atlas(LOSE_PLATFORM_FILEPATH, LOSE_PLATFORMS_MAXSCALE);
+        g_texture_atlas.build(NEAREST, &g_asset_loader);
+    }
+    else
+    {
+        g_texture_manager.prefetch(SUBMARINE_FILEPATH, texture_options(NEAREST, SUBMARINE_INITSCALE));
+        g_texture_manager.prefetch(DEEPOCEAN_FILEPATH, texture_options(NEAREST, BACKGROUND_INITSCALE));
+        g_texture_manager.prefetch(PLATFORM_FILEPATH, texture_options(NEAREST, WIN_PLATFORMS_INITSCALE));
+        g_texture_manager.prefetch(LOSE_PLATFORM_FILEPATH, texture_options(NEAREST, LOSE_PLATFORMS_MAXSCALE));
+    }
+    
+    wait_for_shader_programs({ &g_shader_program, &g_instanced_shader_program });
     
-    g_game_state.player = new Entity(player_texture_id, 1.0f);
+    g_shader_program.use();
+    
+    g_sprite_batch.initialise();
+    g_sprite_renderer.initialise(&g_shader_program);
+    
+    g_game_state.player = new Entity(0, 1.0f);
+    assign_sprite(g_game_state.player, SUBMARINE_FILEPATH, SUBMARINE_INITSCALE);
     
     //g_game_state.player->face_down();
     g_game_state.player->set_acceleration(glm::vec3(0.0f, ACC_OF_GRAVITY * 0.1, 0.0f));
     g_game_state.player->set_position(glm::vec3(0.0f, 4.0f, 0.0f));
+    g_game_state.player->set_depth(PLAYER_DEPTH);
     g_game_state.player->set_scale(SUBMARINE_INITSCALE);
     g_game_state.player->set_width(SUBMARINE_INITSCALE.x);
     g_game_state.player->set_height(SUBMARINE_INITSCALE.y);
     
-    GLuint background_texture_id = load_texture(DEEPOCEAN_FILEPATH, NEAREST);
-    g_game_state.background = new Entity(background_texture_id, 1.0f);
+    g_game_state.background = new Entity(0, 1.0f);
+    assign_sprite(g_game_state.background, DEEPOCEAN_FILEPATH, BACKGROUND_INITSCALE);
     g_game_state.background->set_scale(BACKGROUND_INITSCALE);
+    g_game_state.background->set_depth(BACKGROUND_DEPTH);
     g_game_state.background->update(0.0f);
 
     
@@ -227,16 +487,17 @@ void initialise()
     for (int i = 0; i < PLATFORM_COUNT; i++)
     {
             if(i == 1){
-                g_game_state.platforms[i].set_texture_id(load_texture(PLATFORM_FILEPATH, NEAREST));
+                assign_sprite(&g_game_state.platforms[i], PLATFORM_FILEPATH, WIN_PLATFORMS_INITSCALE);
                 g_game_state.platforms[i].set_position(glm::vec3(-0.5f, -2.8f, 0.0f));
             }else if(i == 2){
-                g_game_state.platforms[i].set_texture_id(load_texture(PLATFORM_FILEPATH, NEAREST));
+                assign_sprite(&g_game_state.platforms[i], PLATFORM_FILEPATH, WIN_PLATFORMS_INITSCALE);
                 g_game_state.platforms[i].set_position(glm::vec3(1.6f, 1.5f, 0.0f));
             }else{
-                g_game_state.platforms[i].set_texture_id(load_texture(PLATFORM_FILEPATH, NEAREST));
+                assign_sprite(&g_game_state.platforms[i], PLATFORM_FILEPATH, WIN_PLATFORMS_INITSCALE);
                 g_game_state.platforms[i].set_position(glm::vec3(3.2f, -2.5f, 0.0f));
             }
             g_game_state.platforms[i].set_scale(WIN_PLATFORMS_INITSCALE);
+            g_game_state.platforms[i].set_depth(PLATFORM_DEPTH);
             g_game_state.platforms[i].set_width((WIN_PLATFORMS_INITSCALE.x)-1.2);
             g_game_state.platforms[i].set_height((WIN_PLATFORMS_INITSCALE.y)-1.2);
             g_game_state.platforms[i].update(0.0f, nullptr, nullptr, 0, 0, ifGameEnd, ifLose, ifWin);
@@ -250,7 +511,7 @@ void initialise()
     }
     
     g_game_state.Platforms_lost[0] = new Entity();
-    g_game_state.Platforms_lost[0]->set_texture_id(load_texture(LOSE_PLATFORM_FILEPATH, NEAREST));
+    assign_sprite(g_game_state.Platforms_lost[0], LOSE_PLATFORM_FILEPATH, LOSE_PLATFORMS_MAXSCALE);
     g_game_state.Platforms_lost[0]->set_position(glm::vec3(-4.0f, -1.0f, 0.0f));
     g_game_state.Platforms_lost[0]->set_rotate_angle(glm::radians(-30.0f));
     g_game_state.Platforms_lost[0]->set_rotate_vec(glm::vec3(0.0f, 0.0f, 1.0f));
@@ -259,7 +520,7 @@ void initialise()
     g_game_state.Platforms_lost[0]->set_height((LOSE_PLATFORMS_INITSCALE.y)-0.1f);
     
     g_game_state.Platforms_lost[1] = new Entity();
-    g_game_state.Platforms_lost[1]->set_texture_id(load_texture(LOSE_PLATFORM_FILEPATH, NEAREST));
+    assign_sprite(g_game_state.Platforms_lost[1], LOSE_PLATFORM_FILEPATH, LOSE_PLATFORMS_MAXSCALE);
     g_game_state.Platforms_lost[1]->set_position(glm::vec3(-3.1f, -1.3f, 0.0f));
     g_game_state.Platforms_lost[1]->set_rotate_angle(glm::radians(70.0f));
     g_game_state.Platforms_lost[1]->set_rotate_vec(glm::vec3(0.0f, 0.0f, 1.0f));
@@ -268,7 +529,7 @@ void initialise()
     g_game_state.Platforms_lost[1]->set_height(0.4f);
     
     g_game_state.Platforms_lost[2] = new Entity();
-    g_game_state.Platforms_lost[2]->set_texture_id(load_texture(LOSE_PLATFORM_FILEPATH, NEAREST));
+    assign_sprite(g_game_state.Platforms_lost[2], LOSE_PLATFORM_FILEPATH, LOSE_PLATFORMS_MAXSCALE);
     g_game_state.Platforms_lost[2]->set_position(glm::vec3(-2.6f, -1.1f, 0.0f));
     g_game_state.Platforms_lost[2]->set_rotate_angle(glm::radians(-20.0f));
     g_game_state.Platforms_lost[2]->set_rotate_vec(glm::vec3(0.0f, 0.0f, 1.0f));
@@ -277,7 +538,7 @@ void initialise()
     g_game_state.Platforms_lost[2]->set_height(0.4f);
     
     g_game_state.Platforms_lost[3] = new Entity();
-    g_game_state.Platforms_lost[3]->set_texture_id(load_texture(LOSE_PLATFORM_FILEPATH, NEAREST));
+    assign_sprite(g_game_state.Platforms_lost[3], LOSE_PLATFORM_FILEPATH, LOSE_PLATFORMS_MAXSCALE);
     g_game_state.Platforms_lost[3]->set_position(glm::vec3(-1.62f, -2.2f, 0.0f));
     g_game_state.Platforms_lost[3]->set_rotate_angle(glm::radians(-55.0f));
     g_game_state.Platforms_lost[3]->set_rotate_vec(glm::vec3(0.0f, 0.0f, 1.0f));
@@ -286,7 +547,7 @@ void initialise()
     g_game_state.Platforms_lost[3]->set_height(0.4f);
     
     g_game_state.Platforms_lost[4] = new Entity();
-    g_game_state.Platforms_lost[4]->set_texture_id(load_texture(LOSE_PLATFORM_FILEPATH, NEAREST));
+    assign_sprite(g_game_state.Platforms_lost[4], LOSE_PLATFORM_FILEPATH, LOSE_PLATFORMS_MAXSCALE);
     g_game_state.Platforms_lost[4]->set_position(glm::vec3(1.2f, -3.1f, 0.0f));
     g_game_state.Platforms_lost[4]->set_rotate_angle(glm::radians(0.0f));
     g_game_state.Platforms_lost[4]->set_rotate_vec(glm::vec3(0.0f, 0.0f, 1.0f));
@@ -295,7 +556,7 @@ void initialise()
     g_game_state.Platforms_lost[4]->set_height(0.4f);
     
     g_game_state.Platforms_lost[5] = new Entity();
-    g_game_state.Platforms_lost[5]->set_texture_id(load_texture(LOSE_PLATFORM_FILEPATH, NEAREST));
+    assign_sprite(g_game_state.Platforms_lost[5], LOSE_PLATFORM_FILEPATH, LOSE_PLATFORMS_MAXSCALE);
     g_game_state.Platforms_lost[5]->set_position(glm::vec3(2.4f, -3.0f, 0.0f));
     g_game_state.Platforms_lost[5]->set_rotate_angle(glm::radians(50.0f));
     g_game_state.Platforms_lost[5]->set_rotate_vec(glm::vec3(0.0f, 0.0f, 1.0f));
@@ -304,74 +565,110 @@ void initialise()
     g_game_state.Platforms_lost[5]->set_height(0.4f);
     
     g_game_state.Platforms_lost[6] = new Entity();
-    g_game_state.Platforms_lost[6]->set_texture_id(load_texture(LOSE_PLATFORM_FILEPATH, NEAREST));
+    assign_sprite(g_game_state.Platforms_lost[6], LOSE_PLATFORM_FILEPATH, LOSE_PLATFORMS_MAXSCALE);
     g_game_state.Platforms_lost[6]->set_position(glm::vec3(4.4f, -2.8f, 0.0f));
     g_game_state.Platforms_lost[6]->set_scale(glm::vec3(2.6f, 0.5f, 0.0f));
     g_game_state.Platforms_lost[6]->set_width(2.5f);
     g_game_state.Platforms_lost[6]->set_height(0.4f);
     
     for(int i = 0; i < PLATFORM_LOSE_COUNT; ++i){
+        g_game_state.Platforms_lost[i]->set_depth(PLATFORM_DEPTH);
         g_game_state.Platforms_lost[i]->update(0.0f, nullptr, nullptr, 0, 0, ifGameEnd, ifLose, ifWin);
     }
     
+    if (INSTANCE_STATIC_PLATFORMS)
+    {
+        for (int i = 0; i < PLATFORM_COUNT; i++) g_win_platforms.push_back(&g_game_state.platforms[i]);
+        for (int i = 0; i < PLATFORM_LOSE_COUNT; i++) g_lose_platforms.push_back(g_game_state.Platforms_lost[i]);
+        
+        build_instance_group(g_win_platform_instances, g_win_platforms);
+        build_instance_group(g_lose_platform_instances, g_lose_platforms);
+    }
+    
     // ————— WIN MESSAGE ————— //
     g_game_state.win_message = new Entity();
-    g_game_state.win_message->set_texture_id(load_texture(MISSIONACCOMPLISH_FILEPATH, NEAREST));
     g_game_state.win_message->set_position(glm::vec3(0.0f, 0.0f, 0.0f));
+    g_game_state.win_message->set_depth(MESSAGE_DEPTH);
     g_game_state.win_message->set_scale(WIN_MESSAGE_INITSCALE);
     if(ifGameEnd && ifWin){
         g_game_state.win_message->update(0.0f, nullptr, nullptr, 0, 0, ifGameEnd, ifLose, ifWin);
     }
     
     g_game_state.lose_message = new Entity();
-    g_game_state.lose_message->set_texture_id(load_texture(MISSIONFAIL_FILEPATH, NEAREST));
     g_game_state.lose_message->set_position(glm::vec3(0.0f, 0.0f, 0.0f));
+    g_game_state.lose_message->set_depth(MESSAGE_DEPTH);
     g_game_state.lose_message->set_scale(LOSE_MESSAGE_INITSCALE);
     if(ifGameEnd && ifLose){
         g_game_state.lose_message->update(0.0f, nullptr, nullptr, 0, 0, ifGameEnd, ifLose, ifWin);
     }
     
+    if (CACHE_STATIC_LAYER && g_static_layer.initialise(VIEWPORT_WIDTH, VIEWPORT_HEIGHT))
+    {
+        g_static_layer.track(g_game_state.background);
+        for (int i = 0; i < PLATFORM_COUNT; i++) g_static_layer.track(&g_game_state.platforms[i]);
+        for (int i = 0; i < PLATFORM_LOSE_COUNT; i++) g_static_layer.track(g_game_state.Platforms_lost[i]);
+    }
+    
+    LOG("Textures resident: " << g_texture_manager.get_texture_count() << " ("
+        << g_texture_manager.get_resident_bytes() / (1024 * 1024) << " MB), atlas pages: "
+        << g_texture_atlas.get_page_count() << " (" << g_texture_atlas.get_resident_bytes() / (1024 * 1024) << " MB)");
+    
     // ————— GENERAL ————— //
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    
+    // The first frame can be drawn before the first step has run
+    publish_snapshot();
 }
 
-void process_input()
+void handle_event(const SDL_Event& event)
 {
-    // VERY IMPORTANT: If nothing is pressed, we don't want to go anywhere
-    g_game_state.player->set_movement(glm::vec3(0.0f));
-    g_game_state.player->set_acceleration_y(ACC_OF_GRAVITY * 0.1);
-    
-    SDL_Event event;
-    while (SDL_PollEvent(&event))
-    {
-        switch (event.type) {
-            case SDL_QUIT:
-            case SDL_WINDOWEVENT_CLOSE:
-                g_app_status = TERMINATED;
-                break;
-                
-            case SDL_KEYDOWN:
-                switch (event.key.keysym.sym) {
-                    case SDLK_q: g_app_status = TERMINATED;
-                    default:     break;
-                }
-                
-            default:
-                break;
-        }
+    switch (event.type) {
+        case SDL_QUIT:
+        case SDL_WINDOWEVENT_CLOSE:
+            g_app_status = TERMINATED;
+            break;
+            
+        case SDL_KEYDOWN:
+            switch (event.key.keysym.sym) {
+                case SDLK_q: g_app_status = TERMINATED;
+                default:     break;
+            }
+            
+        default:
+            break;
     }
+}
+
+InputState poll_input()
+{
+    SDL_Event event;
+    while (SDL_PollEvent(&event)) handle_event(event);
     
     const Uint8 *key_state = SDL_GetKeyboardState(NULL);
+    
+    InputState input;
+    input.left  = key_state[SDL_SCANCODE_A];
+    input.right = key_state[SDL_SCANCODE_D];
+    input.up    = key_state[SDL_SCANCODE_W];
+    input.down  = key_state[SDL_SCANCODE_S];
+    return input;
+}
+
+void apply_input(const InputState& input)
+{
+    // VERY IMPORTANT: If nothing is pressed, we don't want to go anywhere
+    g_game_state.player->set_movement(glm::vec3(0.0f));
+    g_game_state.player->set_acceleration_y(ACC_OF_GRAVITY * 0.1);
 
-    if (key_state[SDL_SCANCODE_A])
+    if (input.left)
     {
         if((g_game_state.player->get_position()).x >= LEFT_BORDER){
             g_game_state.player->accelerate_left();
             g_game_state.player->set_rotate_angle(glm::radians(0.0f));
         }
     }
-    else if (key_state[SDL_SCANCODE_D])
+    else if (input.right)
     {
         if((g_game_state.player->get_position()).x <= RIGHT_BORDER) {
             g_game_state.player->accelerate_right();
@@ -386,11 +683,11 @@ void process_input()
         }
     }
     
-    if (key_state[SDL_SCANCODE_W])
+    if (input.up)
     {
         g_game_state.player->accelerate_up();
     }
-    else if (key_state[SDL_SCANCODE_S])
+    else if (input.down)
     {
         g_game_state.player->accelerate_down();
     }
@@ -399,11 +696,39 @@ void process_input()
         g_game_state.player->normalise_movement();
 }
 
+InputState process_input()
+{
+    InputState input = poll_input();
+    apply_input(input);
+    return input;
+}
+
 
 constexpr float FIXED_TIMESTEP = 1.0f / 60.0f;
 
 float g_time_accumulator = 0.0f;
 
+bool is_near(const Entity* entity, const Entity* other, float margin)
+{
+    float x_distance = std::fabs(entity->get_position().x - other->get_position().x) -
+                       ((entity->get_width() + other->get_width()) / 2.0f);
+    float y_distance = std::fabs(entity->get_position().y - other->get_position().y) -
+                       ((entity->get_height() + other->get_height()) / 2.0f);
+    
+    return x_distance < margin && y_distance < margin;
+}
+
+bool is_near_platform(const Entity* entity, float margin)
+{
+    for (int i = 0; i < PLATFORM_COUNT; i++)
+        if (is_near(entity, &g_game_state.platforms[i], margin)) return true;
+    
+    for (int i = 0; i < PLATFORM_LOSE_COUNT; i++)
+        if (is_near(entity, g_game_state.Platforms_lost[i], margin)) return true;
+    
+    return false;
+}
+
 void update()
 {
     
@@ -423,56 +748,321 @@ void update()
 
     while (delta_time >= FIXED_TIMESTEP)
     {
-        
+        g_game_state.player->store_previous_transform();
         g_game_state.player->update(FIXED_TIMESTEP, g_game_state.platforms, g_game_state.Platforms_lost,
                                     PLATFORM_COUNT, PLATFORM_LOSE_COUNT, ifGameEnd, ifLose, ifWin);
         // for (int i = 0; i < NUMBER_OF_NPCS; i++) g_game_state.npcs[i]->update(delta_time);
-        if(ifGameEnd && ifWin){
-            g_game_state.win_message->update(0.0f, nullptr, nullptr, 0, 0, ifGameEnd, ifLose, ifWin);
-        } else if(ifGameEnd && ifLose){
-            g_game_state.lose_message->update(0.0f, nullptr, nullptr, 0, 0, ifGameEnd, ifLose, ifWin);
-        }
         delta_time -= FIXED_TIMESTEP;
-        
-            
     }
 
     g_time_accumulator = delta_time;
     // g_game_state.player->update(delta_time);
+    
+    publish_snapshot();
+}
+
+void publish_snapshot()
+{
+    GameSnapshot& snapshot = g_snapshots.back();
+    
+    snapshot.player          = g_game_state.player->get_snapshot();
+    snapshot.player_previous = g_game_state.player->get_previous_transform();
+    snapshot.step_time       = g_previous_ticks - g_time_accumulator;
+    snapshot.game_end        = ifGameEnd;
+    snapshot.win             = ifWin;
+    snapshot.lose            = ifLose;
+    snapshot.near_platform   = !ifGameEnd && is_near_platform(g_game_state.player, MESSAGE_PREFETCH_MARGIN);
+    
+    g_snapshots.publish();
+}
+
+// Drops the time spent idle, which would otherwise all be stepped through at once
+void resume_simulation()
+{
+    g_previous_ticks = (float) SDL_GetTicks() / MILLISECONDS_IN_SECOND;
+}
+
+// Runs on its own thread in threaded mode; the player and the game flags belong to it from here on
+void simulation_loop()
+{
+    while (g_app_status == RUNNING)
+    {
+        InputState input;
+        bool idled = false;
+        {
+            std::unique_lock<std::mutex> lock(g_input_mutex);
+            if (IDLE_WHEN_ENDED && ifGameEnd && !g_shared_input.any())
+            {
+                g_input_changed.wait(lock, [] { return g_app_status != RUNNING || g_shared_input.any(); });
+                idled = true;
+            }
+            input = g_shared_input;
+        }
+        
+        if (g_app_status != RUNNING) break;
+        if (idled) resume_simulation();
+        
+        apply_input(input);
+        update();
+        
+        // Sleep off the rest of the step rather than spinning on the clock
+        SDL_Delay((Uint32) ((FIXED_TIMESTEP - g_time_accumulator) * MILLISECONDS_IN_SECOND));
+    }
+}
+
+
+void draw_sprite(const SpriteSnapshot& sprite)
+{
+    if (BATCH_SPRITES) g_sprite_batch.draw(sprite.texture_id, sprite.transform, sprite.uv_rect);
+    else               g_sprite_renderer.draw(sprite.texture_id, sprite.transform, sprite.uv_rect);
+}
+
+void begin_sprites()
+{
+    if (BATCH_SPRITES) g_sprite_batch.begin(&g_shader_program);
+    else               g_sprite_renderer.begin();
+}
+
+void end_sprites()
+{
+    if (BATCH_SPRITES) g_sprite_batch.end();
+    else               g_sprite_renderer.end();
+}
+
+void queue_sprite(const SpriteSnapshot& sprite, RenderLayer layer)
+{
+    g_render_queue.submit(sprite, layer, g_shader_program.get_program_id());
+}
+
+// Only for entities the simulation never touches
+void queue_entity(const Entity* entity, RenderLayer layer)
+{
+    queue_sprite(entity->get_snapshot(), layer);
+}
+
+// The group's members share a texture and a depth, so any one of them stands for all
+void queue_instances(const SpriteInstanceGroup& group, const Entity* member, RenderLayer layer)
+{
+    g_render_queue.submit(&group, member->get_snapshot(), layer, g_instanced_shader_program.get_program_id());
 }
 
+void queue_message(Entity* message, LazyTexture& texture)
+{
+    if (!texture.is_resident())
+    {
+        message->set_texture_id(texture.get());
+        message->set_opaque(g_texture_manager.is_opaque(message->get_texture_id()));
+    }
+    queue_entity(message, OVERLAY_LAYER);
+}
+
+// Behind a depth buffer, opaque sprites sort first and are drawn with blending off, writing depth so
+// texels hidden by nearer ones are rejected before shading; translucent sprites follow, tested against
+// that depth but never writing it. Without one there is no split: the queue is a single back-to-front
+// pass, and blending is only dropped for the opaque runs within it
+void draw_queue()
+{
+    g_render_queue.sort();
+    bool depth_tested = g_render_queue.is_depth_tested();
+    
+    // Starts in the translucent state and follows each run of opaque or translucent commands
+    bool blending = true;
+    if (depth_tested)
+    {
+        glEnable(GL_DEPTH_TEST);
+        glDepthMask(GL_FALSE);
+    }
+    
+    begin_sprites();
+    for (const RenderCommand& command : g_render_queue.get_commands())
+    {
+        bool translucent = RenderQueue::is_translucent(command);
+        if (translucent != blending)
+        {
+            end_sprites();
+            if (translucent) glEnable(GL_BLEND);
+            else             glDisable(GL_BLEND);
+            if (depth_tested) glDepthMask(translucent ? GL_FALSE : GL_TRUE);
+            begin_sprites();
+            blending = translucent;
+        }
+        
+        if (command.instances == nullptr)
+        {
+            draw_sprite(command.sprite);
+            continue;
+        }
+        
+        end_sprites();
+        g_sprite_renderer.draw_instanced(&g_instanced_shader_program, *command.instances);
+        begin_sprites();
+    }
+    end_sprites();
+    
+    glEnable(GL_BLEND);
+    
+    // glClear only touches depth while writes are on
+    if (depth_tested)
+    {
+        glDepthMask(GL_TRUE);
+        glDisable(GL_DEPTH_TEST);
+    }
+}
+
+// Queues everything that never moves
+void queue_static_entities()
+{
+    queue_entity(g_game_state.background, BACKGROUND_LAYER);
+    
+    if (INSTANCE_STATIC_PLATFORMS)
+    {
+        // Runs with every static layer capture, or every frame without one; unchanged groups cost a revision sum
+        refresh_instance_group(g_win_platform_instances, g_win_platforms);
+        refresh_instance_group(g_lose_platform_instances, g_lose_platforms);
+        
+        queue_instances(g_win_platform_instances, &g_game_state.platforms[0], WORLD_LAYER);
+        queue_instances(g_lose_platform_instances, g_game_state.Platforms_lost[0], WORLD_LAYER);
+    }
+    else
+    {
+        for (int i = 0; i < PLATFORM_COUNT; i++){
+            queue_entity(&g_game_state.platforms[i], WORLD_LAYER);
+        }
+        
+        for (int i = 0; i < PLATFORM_LOSE_COUNT; ++i){
+            queue_entity(g_game_state.Platforms_lost[i], WORLD_LAYER);
+        }
+    }
+}
 
 void render()
 {
-    glClear(GL_COLOR_BUFFER_BIT);
+    g_snapshots.acquire();
+    const GameSnapshot& snapshot = g_snapshots.front();
+    
+    // Decoding and uploading stay on this thread, the one that owns the texture manager
+    if (snapshot.near_platform)
+    {
+        g_win_message_texture.prefetch();
+        g_lose_message_texture.prefetch();
+    }
+    
+    glClear(g_depth_buffer ? GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT : GL_COLOR_BUFFER_BIT);
+    
+    if (g_static_layer.is_initialised())
+    {
+        if (g_static_layer.needs_capture())
+        {
+            // The layer has no depth attachment, so it is drawn in a single painter's-order pass
+            g_static_layer.begin_capture();
+            g_render_queue.begin(false);
+            queue_static_entities();
+            draw_queue();
+            g_static_layer.end_capture();
+        }
+        
+        g_static_layer.composite(&g_sprite_renderer,
+                                 glm::vec3((ORTHO_LEFT + ORTHO_RIGHT) / 2.0f, (ORTHO_BOTTOM + ORTHO_TOP) / 2.0f,
+                                           BACKGROUND_DEPTH),
+                                 glm::vec2(ORTHO_RIGHT - ORTHO_LEFT, ORTHO_TOP - ORTHO_BOTTOM));
+    }
     
-    g_game_state.background->render(&g_shader_program);
+    g_render_queue.begin(g_depth_buffer);
+    if (!g_static_layer.is_initialised()) queue_static_entities();
     
-    g_game_state.player->render(&g_shader_program);
+    // Draw the player part of the way from its previous step to its current one, by however much
+    // time has passed since; the picture trails the simulation by up to a step but never judders
+    float now   = (float) SDL_GetTicks() / MILLISECONDS_IN_SECOND,
+          alpha = glm::clamp((now - snapshot.step_time) / FIXED_TIMESTEP, 0.0f, 1.0f);
+    
+    SpriteSnapshot player = snapshot.player;
+    player.transform = Transform2D::interpolate(snapshot.player_previous, snapshot.player.transform, alpha);
+    queue_sprite(player, WORLD_LAYER);
     
     /*
     for (int i = 0; i < NUMBER_OF_NPCS; i++)
-        g_game_state.npcs[i]->render(&g_shader_program);
+        queue_entity(g_game_state.npcs[i], WORLD_LAYER);
     */
-    for (int i = 0; i < PLATFORM_COUNT; i++){
-        g_game_state.platforms[i].render(&g_shader_program);
-    }
     
-    for (int i = 0; i < PLATFORM_LOSE_COUNT; ++i){
-        g_game_state.Platforms_lost[i]->render(&g_shader_program);
+    if(snapshot.game_end && snapshot.win){
+        queue_message(g_game_state.win_message, g_win_message_texture);
+    } else if(snapshot.game_end && snapshot.lose){
+        queue_message(g_game_state.lose_message, g_lose_message_texture);
     }
     
-    if(ifGameEnd && ifWin){
-        g_game_state.win_message->render(&g_shader_program);
-    } else if(ifGameEnd && ifLose){
-        g_game_state.lose_message->render(&g_shader_program);
-    }
+    draw_queue();
+    
     SDL_GL_SwapWindow(g_display_window);
+    g_frame_pacer.end_frame();
+    
+    Entity::TransformCounters transforms = Entity::get_transform_counters();
+    g_transform_totals.rebuilt += transforms.rebuilt;
+    g_transform_totals.cached  += transforms.cached;
+    g_frames_rendered++;
+    Entity::reset_transform_counters();
+}
+
+
+// Blocks the main thread until a key or button goes down. Expose and resize events are
+// answered with a single present of the last snapshot in the meantime
+void wait_for_input()
+{
+    SDL_Event event;
+    while (g_app_status == RUNNING && SDL_WaitEvent(&event))
+    {
+        handle_event(event);
+        
+        switch (event.type) {
+            case SDL_KEYDOWN:
+            case SDL_MOUSEBUTTONDOWN:
+                g_frame_pacer.restart();
+                return;
+                
+            case SDL_WINDOWEVENT:
+                if (event.window.event == SDL_WINDOWEVENT_EXPOSED ||
+                    event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED)
+                {
+                    g_frame_pacer.restart();
+                    render();
+                }
+                break;
+                
+            default:
+                break;
+        }
+    }
 }
 
 
 void shutdown()
 {
+    LOG("Shader cache hits/misses: " << g_shader_cache.get_hits() << "/" << g_shader_cache.get_misses());
+    ShaderProgram::StateCounters counters = ShaderProgram::get_state_counters();
+    LOG("Program binds issued/skipped: " << counters.program_binds_issued << "/" << counters.program_binds_skipped
+        << ", uniforms issued/skipped: " << counters.uniforms_issued << "/" << counters.uniforms_skipped);
+    if (g_frames_rendered > 0)
+        LOG("Transforms rebuilt/cached per frame: " << (float) g_transform_totals.rebuilt / g_frames_rendered << "/"
+            << (float) g_transform_totals.cached / g_frames_rendered);
+    
+    LOG("Static layer captures: " << g_static_layer.get_capture_count());
+    if (g_frame_pacer.get_frame_count() > 1)
+        LOG("Frame time mean/std dev/min/max (ms): " << g_frame_pacer.get_mean_frame_time() * 1000.0 << "/"
+            << std::sqrt(g_frame_pacer.get_frame_time_variance()) * 1000.0 << "/"
+            << g_frame_pacer.get_min_frame_time() * 1000.0 << "/" << g_frame_pacer.get_max_frame_time() * 1000.0);
+    
+    g_static_layer.cleanup();
+    g_sprite_batch.cleanup();
+    g_sprite_renderer.cleanup();
+    g_win_platform_instances.cleanup();
+    g_lose_platform_instances.cleanup();
+    g_win_message_texture.release();
+    g_lose_message_texture.release();
+    g_texture_manager.release_all();
+    g_asset_loader.stop();
+    g_asset_archive.close();
+    g_texture_atlas.cleanup();
+    g_texture_uploader.cleanup();
+    g_camera.cleanup();
     SDL_Quit();
     delete   g_game_state.player;
     delete   g_game_state.background;
@@ -490,11 +1080,47 @@ int main(int argc, char* argv[])
 {
     initialise();
     
-    while (g_app_status == RUNNING)
+    if (THREADED_SIMULATION)
     {
-        process_input();
-        update();
-        render();
+        std::thread simulation(simulation_loop);
+        
+        // SDL wants events pumped on the thread that created the window, which also owns the context
+        while (g_app_status == RUNNING)
+        {
+            InputState input = poll_input();
+            {
+                std::lock_guard<std::mutex> lock(g_input_mutex);
+                g_shared_input = input;
+            }
+            g_input_changed.notify_one();
+            render();
+            
+            // The simulation thread parks itself on the same condition, so both sides go quiet together
+            if (IDLE_WHEN_ENDED && g_snapshots.front().game_end && !input.any()) wait_for_input();
+        }
+        
+        // Passing through the mutex means the simulation thread is either already waiting or
+        // will see the new status when it checks, so this wakeup can't be missed
+        {
+            std::lock_guard<std::mutex> lock(g_input_mutex);
+        }
+        g_input_changed.notify_all();
+        simulation.join();
+    }
+    else
+    {
+        while (g_app_status == RUNNING)
+        {
+            InputState input = process_input();
+            update();
+            render();
+            
+            if (IDLE_WHEN_ENDED && ifGameEnd && !input.any())
+            {
+                wait_for_input();
+                resume_simulation();
+            }
+        }
     }
     
     shutdown();
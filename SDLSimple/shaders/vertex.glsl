@@ -1,8 +1,17 @@
 attribute vec4 position;
 
 uniform mat4 modelMatrix;
+
+#ifdef CAMERA_UNIFORM_BUFFER
+layout(std140) uniform Camera
+{
+    mat4 viewMatrix;
+    mat4 projectionMatrix;
+};
+#else
 uniform mat4 viewMatrix;
 uniform mat4 projectionMatrix;
+#endif
 
 void main()
 {
@@ -0,0 +1,31 @@
+attribute vec4 position;
+attribute vec2 texCoord;
+
+// Per-instance attributes, advanced once per sprite rather than per vertex
+attribute vec4 instanceLinear;
+attribute vec3 instanceTranslation;
+attribute vec4 instanceUvRect;
+attribute vec4 instanceTint;
+
+#ifdef CAMERA_UNIFORM_BUFFER
+layout(std140) uniform Camera
+{
+    mat4 viewMatrix;
+    mat4 projectionMatrix;
+};
+#else
+uniform mat4 viewMatrix;
+uniform mat4 projectionMatrix;
+#endif
+
+varying vec2 texCoordVar;
+varying vec4 tintVar;
+
+void main()
+{
+	vec4 p = viewMatrix * vec4(mat2(instanceLinear.xy, instanceLinear.zw) * position.xy + instanceTranslation.xy,
+                               instanceTranslation.z, 1.0);
+    texCoordVar = instanceUvRect.xy + texCoord * instanceUvRect.zw;
+    tintVar = instanceTint;
+	gl_Position = projectionMatrix * p;
+}
@@ -1,15 +1,29 @@
 attribute vec4 position;
 attribute vec2 texCoord;
 
-uniform mat4 modelMatrix;
+// The model transform as a 2x2 linear part (columns in xy and zw) plus a translation whose z is depth
+uniform vec4 modelLinear;
+uniform vec3 modelTranslation;
+uniform vec4 uvRect;
+
+// Shared by every program: a single uniform buffer when the context has them, plain uniforms otherwise
+#ifdef CAMERA_UNIFORM_BUFFER
+layout(std140) uniform Camera
+{
+    mat4 viewMatrix;
+    mat4 projectionMatrix;
+};
+#else
 uniform mat4 viewMatrix;
 uniform mat4 projectionMatrix;
+#endif
 
 varying vec2 texCoordVar;
 
 void main()
 {
-	vec4 p = viewMatrix * modelMatrix  * position;
-    texCoordVar = texCoord;
+	vec4 p = viewMatrix * vec4(mat2(modelLinear.xy, modelLinear.zw) * position.xy + modelTranslation.xy,
+                               position.z + modelTranslation.z, 1.0);
+    texCoordVar = uvRect.xy + texCoord * uvRect.zw;
 	gl_Position = projectionMatrix * p;
 }
\ No newline at end of file
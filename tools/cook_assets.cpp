@@ -0,0 +1,111 @@
+// Offline asset cooker: decodes every image once and writes them, with full mip
+// chains, into a single archive that the game maps at startup (see AssetArchive.h).
+//
+// Build (from the repository root):
+//     c++ -std=c++17 -O2 -I SDLSimple tools/cook_assets.cpp SDLSimple/Image.cpp -o cook_assets
+// Run from SDLSimple/ so entry names match the paths the game asks for:
+//     cd SDLSimple && ../cook_assets assets/textures.pak assets/*.png assets/*.jpg
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+#include "Image.h"
+#include "AssetArchive.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+struct CookedImage
+{
+    std::string        name;
+    std::vector<Image> levels;
+};
+
+std::size_t align_up(std::size_t value, std::size_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " <output archive> <image>..." << std::endl;
+        return 1;
+    }
+
+    std::vector<CookedImage> images;
+    for (int i = 2; i < argc; i++)
+    {
+        CookedImage cooked;
+        cooked.name = argv[i];
+        if (cooked.name.size() >= sizeof(ArchiveEntry::name))
+        {
+            std::cerr << "Skipping " << cooked.name << ": name too long." << std::endl;
+            continue;
+        }
+
+        Image base;
+        if (!load_image(argv[i], base)) continue;
+
+        std::vector<Image> mips;
+        build_mip_chain(base, mips, 32);
+
+        cooked.levels.push_back(std::move(base));
+        for (Image &mip : mips) cooked.levels.push_back(std::move(mip));
+
+        images.push_back(std::move(cooked));
+    }
+
+    // ————— INDEX ————— //
+    ArchiveHeader header = {};
+    std::memcpy(header.magic, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC));
+    header.version     = ARCHIVE_VERSION;
+    header.entry_count = (uint32_t) images.size();
+
+    std::vector<ArchiveEntry> entries(images.size());
+    std::size_t offset = align_up(sizeof(ArchiveHeader) + entries.size() * sizeof(ArchiveEntry), ARCHIVE_ALIGNMENT);
+
+    for (std::size_t i = 0; i < images.size(); i++)
+    {
+        ArchiveEntry &entry = entries[i];
+        std::memset(&entry, 0, sizeof(entry));
+        std::memcpy(entry.name, images[i].name.c_str(), images[i].name.size());
+
+        entry.width       = (uint32_t) images[i].levels[0].width;
+        entry.height      = (uint32_t) images[i].levels[0].height;
+        entry.level_count = (uint32_t) images[i].levels.size();
+        entry.format      = ARCHIVE_RGBA8;
+        entry.offset      = offset;
+
+        for (const Image &level : images[i].levels) entry.byte_size += level.pixels.size();
+        offset = align_up(offset + entry.byte_size, ARCHIVE_ALIGNMENT);
+    }
+
+    // ————— DATA ————— //
+    std::ofstream output(argv[1], std::ios::binary);
+    if (!output)
+    {
+        std::cerr << "Unable to write " << argv[1] << std::endl;
+        return 1;
+    }
+
+    output.write((const char *) &header, sizeof(header));
+    output.write((const char *) entries.data(), entries.size() * sizeof(ArchiveEntry));
+
+    for (std::size_t i = 0; i < images.size(); i++)
+    {
+        output.seekp(entries[i].offset);
+        for (const Image &level : images[i].levels)
+            output.write((const char *) level.pixels.data(), level.pixels.size());
+
+        std::cout << images[i].name << ": " << entries[i].width << "x" << entries[i].height << ", "
+                  << entries[i].level_count << " levels, " << entries[i].byte_size / 1024 << " KB" << std::endl;
+    }
+
+    // Pad the tail so the last entry ends on an aligned boundary too
+    output.seekp(offset - 1);
+    output.put(0);
+
+    return 0;
+}
@@ -0,0 +1,302 @@
+// Offline texture compressor: writes a BC1 (opaque) or BC3 (with alpha) .ktx2 next to
+// each source image, with a full mip chain. The game picks these up in place of the
+// PNG/JPEG whenever the context exposes GL_EXT_texture_compression_s3tc.
+//
+// Build (from the repository root):
+//     c++ -std=c++17 -O2 -I SDLSimple tools/cook_ktx2.cpp SDLSimple/Image.cpp SDLSimple/KtxTexture.cpp -o cook_ktx2
+// Run:
+//     ./cook_ktx2 SDLSimple/assets/*.png SDLSimple/assets/*.jpg
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+#include "Image.h"
+#include "KtxTexture.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+constexpr int BLOCK_PIXELS = 16;
+
+// ————— DATA FORMAT DESCRIPTOR ————— //
+constexpr uint8_t DF_MODEL_BC1A = 128,
+                  DF_MODEL_BC3  = 130,
+                  DF_PRIMARIES_BT709 = 1,
+                  DF_TRANSFER_LINEAR = 1,
+                  DF_CHANNEL_COLOR   = 0,
+                  DF_CHANNEL_BC3_ALPHA = 15;
+
+struct BlockPixel
+{
+    float r, g, b, a;
+};
+
+uint16_t pack_565(float r, float g, float b)
+{
+    int r5 = std::clamp((int) std::lround(r * 31.0f / 255.0f), 0, 31),
+        g6 = std::clamp((int) std::lround(g * 63.0f / 255.0f), 0, 63),
+        b5 = std::clamp((int) std::lround(b * 31.0f / 255.0f), 0, 31);
+    return (uint16_t) ((r5 << 11) | (g6 << 5) | b5);
+}
+
+void unpack_565(uint16_t colour, float rgb[3])
+{
+    int r5 = (colour >> 11) & 31, g6 = (colour >> 5) & 63, b5 = colour & 31;
+    rgb[0] = (float) ((r5 << 3) | (r5 >> 2));
+    rgb[1] = (float) ((g6 << 2) | (g6 >> 4));
+    rgb[2] = (float) ((b5 << 3) | (b5 >> 2));
+}
+
+// Endpoints are the extremes of the block along its principal colour axis. Fully
+// transparent pixels are left out, since nobody will ever see their colour
+void encode_colour_block(const BlockPixel pixels[BLOCK_PIXELS], unsigned char output[8])
+{
+    std::vector<const BlockPixel*> visible;
+    for (int i = 0; i < BLOCK_PIXELS; i++) if (pixels[i].a > 0.0f) visible.push_back(&pixels[i]);
+    if (visible.empty()) for (int i = 0; i < BLOCK_PIXELS; i++) visible.push_back(&pixels[i]);
+
+    float mean[3] = { 0.0f, 0.0f, 0.0f };
+    for (const BlockPixel *pixel : visible) { mean[0] += pixel->r; mean[1] += pixel->g; mean[2] += pixel->b; }
+    for (float &channel : mean) channel /= (float) visible.size();
+
+    float covariance[6] = { 0.0f };
+    for (const BlockPixel *pixel : visible)
+    {
+        float r = pixel->r - mean[0], g = pixel->g - mean[1], b = pixel->b - mean[2];
+        covariance[0] += r * r; covariance[1] += r * g; covariance[2] += r * b;
+        covariance[3] += g * g; covariance[4] += g * b; covariance[5] += b * b;
+    }
+
+    // A few rounds of power iteration are plenty for a 3x3 matrix
+    float axis[3] = { 1.0f, 1.0f, 1.0f };
+    for (int iteration = 0; iteration < 8; iteration++)
+    {
+        float next[3] = {
+            covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2],
+            covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2],
+            covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2]
+        };
+        float length = std::sqrt(next[0] * next[0] + next[1] * next[1] + next[2] * next[2]);
+        if (length < 1e-6f) break;
+        for (int c = 0; c < 3; c++) axis[c] = next[c] / length;
+    }
+
+    float lowest = 1e9f, highest = -1e9f;
+    for (const BlockPixel *pixel : visible)
+    {
+        float projection = (pixel->r - mean[0]) * axis[0] + (pixel->g - mean[1]) * axis[1] + (pixel->b - mean[2]) * axis[2];
+        lowest  = std::min(lowest, projection);
+        highest = std::max(highest, projection);
+    }
+
+    uint16_t colour0 = pack_565(mean[0] + axis[0] * highest, mean[1] + axis[1] * highest, mean[2] + axis[2] * highest),
+             colour1 = pack_565(mean[0] + axis[0] * lowest,  mean[1] + axis[1] * lowest,  mean[2] + axis[2] * lowest);
+
+    // colour0 > colour1 selects the four-colour mode
+    if (colour0 < colour1) std::swap(colour0, colour1);
+
+    float palette[4][3];
+    unpack_565(colour0, palette[0]);
+    unpack_565(colour1, palette[1]);
+    for (int c = 0; c < 3; c++)
+    {
+        palette[2][c] = (2.0f * palette[0][c] + palette[1][c]) / 3.0f;
+        palette[3][c] = (palette[0][c] + 2.0f * palette[1][c]) / 3.0f;
+    }
+
+    uint32_t indices = 0;
+    if (colour0 != colour1)
+    {
+        for (int i = 0; i < BLOCK_PIXELS; i++)
+        {
+            int   best       = 0;
+            float best_error = 1e30f;
+            for (int entry = 0; entry < 4; entry++)
+            {
+                float dr = pixels[i].r - palette[entry][0],
+                      dg = pixels[i].g - palette[entry][1],
+                      db = pixels[i].b - palette[entry][2];
+                float error = dr * dr + dg * dg + db * db;
+                if (error < best_error) { best_error = error; best = entry; }
+            }
+            indices |= (uint32_t) best << (i * 2);
+        }
+    }
+
+    output[0] = colour0 & 0xFF; output[1] = colour0 >> 8;
+    output[2] = colour1 & 0xFF; output[3] = colour1 >> 8;
+    for (int i = 0; i < 4; i++) output[4 + i] = (indices >> (i * 8)) & 0xFF;
+}
+
+// Eight-value mode (alpha0 > alpha1): six interpolated steps between the block's extremes
+void encode_alpha_block(const BlockPixel pixels[BLOCK_PIXELS], unsigned char output[8])
+{
+    float lowest = 255.0f, highest = 0.0f;
+    for (int i = 0; i < BLOCK_PIXELS; i++)
+    {
+        lowest  = std::min(lowest,  pixels[i].a);
+        highest = std::max(highest, pixels[i].a);
+    }
+
+    int alpha0 = (int) highest, alpha1 = (int) lowest;
+    uint64_t indices = 0;
+
+    if (alpha0 != alpha1)
+    {
+        float palette[8] = { (float) alpha0, (float) alpha1 };
+        for (int step = 1; step < 7; step++) palette[step + 1] = ((7 - step) * alpha0 + step * alpha1) / 7.0f;
+
+        for (int i = 0; i < BLOCK_PIXELS; i++)
+        {
+            int   best       = 0;
+            float best_error = 1e30f;
+            for (int entry = 0; entry < 8; entry++)
+            {
+                float error = std::fabs(pixels[i].a - palette[entry]);
+                if (error < best_error) { best_error = error; best = entry; }
+            }
+            indices |= (uint64_t) best << (i * 3);
+        }
+    }
+
+    output[0] = (unsigned char) alpha0;
+    output[1] = (unsigned char) alpha1;
+    for (int i = 0; i < 6; i++) output[2 + i] = (indices >> (i * 8)) & 0xFF;
+}
+
+std::vector<unsigned char> encode_level(const Image &image, bool with_alpha)
+{
+    int blocks_wide = (image.width + 3) / 4, blocks_high = (image.height + 3) / 4;
+    std::vector<unsigned char> output((std::size_t) blocks_wide * blocks_high * (with_alpha ? 16 : 8));
+    unsigned char *block = output.data();
+
+    for (int block_y = 0; block_y < blocks_high; block_y++)
+    {
+        for (int block_x = 0; block_x < blocks_wide; block_x++)
+        {
+            // Blocks hanging off the edge repeat the last row/column
+            BlockPixel pixels[BLOCK_PIXELS];
+            for (int i = 0; i < BLOCK_PIXELS; i++)
+            {
+                int x = std::min(block_x * 4 + i % 4, image.width  - 1),
+                    y = std::min(block_y * 4 + i / 4, image.height - 1);
+                const unsigned char *source = image.pixel(x, y);
+                pixels[i] = { (float) source[0], (float) source[1], (float) source[2], (float) source[3] };
+            }
+
+            if (with_alpha)
+            {
+                encode_alpha_block(pixels, block);
+                block += 8;
+            }
+            encode_colour_block(pixels, block);
+            block += 8;
+        }
+    }
+
+    return output;
+}
+
+std::vector<unsigned char> data_format_descriptor(bool with_alpha)
+{
+    int sample_count = with_alpha ? 2 : 1;
+    uint32_t block_size = 24 + 16 * sample_count;
+
+    std::vector<uint32_t> words = {
+        4 + block_size,                 // dfdTotalSize
+        0,                              // vendorId 0 (Khronos), descriptorType 0 (basic)
+        2u | (block_size << 16),        // versionNumber 2, descriptorBlockSize
+        (uint32_t) (with_alpha ? DF_MODEL_BC3 : DF_MODEL_BC1A) | (DF_PRIMARIES_BT709 << 8) | (DF_TRANSFER_LINEAR << 16),
+        3u | (3u << 8),                 // 4x4 texel blocks
+        with_alpha ? 16u : 8u,          // bytesPlane0
+        0
+    };
+
+    if (with_alpha)
+    {
+        words.insert(words.end(), { 0u | (63u << 16) | ((uint32_t) DF_CHANNEL_BC3_ALPHA << 24), 0, 0, 0xFFFFFFFFu });
+        words.insert(words.end(), { 64u | (63u << 16) | ((uint32_t) DF_CHANNEL_COLOR << 24), 0, 0, 0xFFFFFFFFu });
+    }
+    else words.insert(words.end(), { 0u | (63u << 16) | ((uint32_t) DF_CHANNEL_COLOR << 24), 0, 0, 0xFFFFFFFFu });
+
+    std::vector<unsigned char> bytes(words.size() * sizeof(uint32_t));
+    std::memcpy(bytes.data(), words.data(), bytes.size());
+    return bytes;
+}
+
+std::size_t align_up(std::size_t value, std::size_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+bool cook(const char *source_path)
+{
+    Image base;
+    if (!load_image(source_path, base)) return false;
+
+    bool with_alpha = false;
+    for (std::size_t i = 3; i < base.pixels.size() && !with_alpha; i += Image::BYTES_PER_PIXEL)
+        with_alpha = base.pixels[i] < 255;
+
+    std::vector<Image> mips;
+    build_mip_chain(base, mips, 32);
+
+    std::vector<std::vector<unsigned char>> levels = { encode_level(base, with_alpha) };
+    for (const Image &mip : mips) levels.push_back(encode_level(mip, with_alpha));
+
+    std::vector<unsigned char> dfd = data_format_descriptor(with_alpha);
+
+    Ktx2Header header = {};
+    std::memcpy(header.identifier, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER));
+    header.vk_format       = with_alpha ? KTX_BC3_UNORM : KTX_BC1_RGB_UNORM;
+    header.type_size       = 1;
+    header.pixel_width     = (uint32_t) base.width;
+    header.pixel_height    = (uint32_t) base.height;
+    header.face_count      = 1;
+    header.level_count     = (uint32_t) levels.size();
+    header.dfd_byte_offset = (uint32_t) (sizeof(Ktx2Header) + levels.size() * sizeof(Ktx2LevelIndex));
+    header.dfd_byte_length = (uint32_t) dfd.size();
+
+    // The level index lists the base first, but the data is laid out smallest level first
+    std::vector<Ktx2LevelIndex> index(levels.size());
+    std::size_t offset = header.dfd_byte_offset + dfd.size();
+    for (int level = (int) levels.size() - 1; level >= 0; level--)
+    {
+        offset = align_up(offset, 16);
+        index[level] = { offset, levels[level].size(), levels[level].size() };
+        offset += levels[level].size();
+    }
+
+    std::string output_path = KtxTexture::path_for(source_path);
+    std::ofstream output(output_path, std::ios::binary);
+    if (!output) return false;
+
+    output.write((const char *) &header, sizeof(header));
+    output.write((const char *) index.data(), index.size() * sizeof(Ktx2LevelIndex));
+    output.write((const char *) dfd.data(), dfd.size());
+    for (int level = (int) levels.size() - 1; level >= 0; level--)
+    {
+        output.seekp(index[level].byte_offset);
+        output.write((const char *) levels[level].data(), levels[level].size());
+    }
+
+    std::cout << output_path << ": " << base.width << "x" << base.height << (with_alpha ? " BC3, " : " BC1, ")
+              << levels.size() << " levels, " << (offset - header.dfd_byte_offset) / 1024 << " KB" << std::endl;
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <image>..." << std::endl;
+        return 1;
+    }
+
+    int failures = 0;
+    for (int i = 1; i < argc; i++) if (!cook(argv[i])) failures++;
+
+    return failures == 0 ? 0 : 1;
+}
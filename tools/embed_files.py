@@ -0,0 +1,92 @@
+#!/usr/bin/env python3
+"""Writes a header that embeds files into the executable as constexpr byte arrays.
+
+Shaders are embedded so startup needs no file I/O for them and the game no longer
+depends on its working directory. The Xcode project runs this as its "Embed Shaders"
+build phase before compiling, so edits under shaders/ are picked up by a normal build.
+Outside Xcode, run it from the directory holding the project:
+
+    python3 tools/embed_files.py SDLSimple/EmbeddedShaders.h SDLSimple SDLSimple/shaders/*.glsl
+
+Paths are stored relative to the root directory (the second argument), matching the
+paths the game already uses, e.g. "shaders/vertex_textured.glsl".
+"""
+
+import os
+import re
+import sys
+
+BYTES_PER_LINE = 16
+
+
+def identifier_for(path):
+    return re.sub(r'[^0-9A-Za-z]', '_', path).upper()
+
+
+def main():
+    if len(sys.argv) < 4:
+        sys.exit('Usage: embed_files.py <output header> <root directory> <file>...')
+
+    output_path, root = sys.argv[1], sys.argv[2]
+    # Relative to the root whether the shell expanded the globs from there or not
+    files = sorted(os.path.relpath(os.path.join(root, path) if not os.path.exists(path) else path, root)
+                   for path in sys.argv[3:])
+
+    lines = [
+        '#pragma once',
+        '',
+        '// Generated by tools/embed_files.py (the Embed Shaders build phase); do not edit.',
+        '',
+        '#include <cstddef>',
+        '#include <cstring>',
+        '',
+        'struct EmbeddedFile',
+        '{',
+        '    const char *path;',
+        '    const char *data;',
+        '    std::size_t size;',
+        '};',
+        '',
+    ]
+
+    for path in files:
+        with open(os.path.join(root, path), 'rb') as source:
+            data = source.read()
+
+        lines.append('// %s' % path.replace(os.sep, '/'))
+        lines.append('constexpr char %s[] = {' % identifier_for(path))
+        # Null-terminated so the data can also be used as a C string; size excludes the terminator
+        data += b'\0'
+        for start in range(0, len(data), BYTES_PER_LINE):
+            chunk = data[start:start + BYTES_PER_LINE]
+            lines.append('    ' + ', '.join('0x%02x' % byte for byte in chunk) + ',')
+        lines.append('};')
+        lines.append('')
+
+    lines.append('constexpr EmbeddedFile EMBEDDED_FILES[] = {')
+    for path in files:
+        name = identifier_for(path)
+        lines.append('    { "%s", %s, sizeof(%s) - 1 },' % (path.replace(os.sep, '/'), name, name))
+    lines.append('};')
+    lines.append('')
+    lines.append('inline const EmbeddedFile* find_embedded_file(const char *path)')
+    lines.append('{')
+    lines.append('    for (const EmbeddedFile &file : EMBEDDED_FILES)')
+    lines.append('        if (std::strcmp(file.path, path) == 0) return &file;')
+    lines.append('    return nullptr;')
+    lines.append('}')
+
+    text = '\n'.join(lines) + '\n'
+
+    # Left untouched when nothing changed, so the sources including it aren't rebuilt
+    if os.path.exists(output_path):
+        with open(output_path, 'r', newline='\n') as existing:
+            if existing.read() == text:
+                return
+
+    with open(output_path, 'w', newline='\n') as output:
+        output.write(text)
+
+
+if __name__ == '__main__':
+    main()